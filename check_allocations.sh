@@ -0,0 +1,25 @@
+#!/bin/sh
+# Builds with -DALLOCATION_HOOK and solves a small board, fails when ThisThread::Explore reached operator new
+set -e
+Root=$( cd "$( dirname "$0" )" && pwd )
+Work=$( mktemp -d )
+trap 'rm -rf "$Work"' EXIT
+
+${CXX:-g++} -std=c++20 -O2 -march=native -pthread -Wall -Wextra -Werror -DALLOCATION_HOOK -o "$Work/pop_star_8x8" "$Root/pop_star_8x8.cpp"
+
+cat > "$Work/puzzle.txt" <<EOF
+11212222
+11212212
+21121111
+21211221
+21122121
+12122122
+22121221
+22121122
+EOF
+
+cd "$Work"
+Status=0
+./pop_star_8x8 < /dev/null > solve.log || Status=$?
+grep -a "Final Score\|Hot Path Allocations" solve.log
+exit $Status
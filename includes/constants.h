@@ -9,16 +9,45 @@ constexpr auto MAX_layer = 40;
 
 constexpr auto PUZZLE_SIZE = MAX_x * MAX_y;
 
-constexpr auto PUZZLE_PATH   = "puzzle.txt";
-constexpr auto SOLUTION_PATH = "puzzle_solution.txt";
-constexpr auto ARCHIVE_PATH  = "E:\\__PUZZLE_ARCHIVE\\ARCHIVE_";
+constexpr auto PUZZLE_PATH     = "puzzle.txt";
+constexpr auto SOLUTION_PATH   = "puzzle_solution.txt";
+constexpr auto CHECKPOINT_PATH = "puzzle_checkpoint.bin";
+constexpr auto ANALYSIS_PATH   = "puzzle_analysis.txt";
+constexpr auto ARCHIVE_PATH    = "E:\\__PUZZLE_ARCHIVE\\ARCHIVE_";
 
-constexpr auto HASH_SIZE = 700001; // prime option: 99991, 199999, 499099, 599999, 700001, 999979 1999111 2097143 
+constexpr auto HASH_BITS = "19"; // --hash-bits without a value, --worker fallback and --predict endgames, a solve sizes its own from Prediction
 
-constexpr auto OPTION_CAPACITY = 16;
+constexpr auto OPTION_CAPACITY = PUZZLE_SIZE / 2; // every group holds at least 2 cells
+
+constexpr auto ARENA_BLOCK_SIZE = 1 << 16; // nodes per arena block
 
 constexpr auto THREAD_PERMISSION = 10;
 
+constexpr auto FRONT_CACHE_BITS = 14; // 16K entries of 16 bytes per thread, 256 KB stays in L2
+
+constexpr auto CHECKPOINT_INTERVAL = "600"; // seconds, default of --checkpoint
+
+constexpr auto PREDICTION_SAMPLES = "500"; // random descents, default of --predict and the count PREDICTION_FIT was made at
+constexpr auto PREDICTION_BUDGET  = 50;    // search nodes spent proving one candidate parent reachable
+constexpr auto PREDICTION_SIZING  = 100;   // descents sizing the table of a solve, the estimate drifts by up to a quarter that low
+constexpr auto PREDICTION_REFINE_BITS = 22; // from that table up, 256 MB and more, sizing resamples at PREDICTION_SAMPLES
+
+// written by prediction/fit.py from the boards and exact counts beside it
+constexpr double PREDICTION_FIT[]    = { -1.315, 0.456, 0.647, 0.258 }; // log States on 1, log mean, log median, colours
+constexpr auto PREDICTION_SPREAD     = 0.578;     // standard deviation of that fit with each board left out, in log States
+constexpr auto PREDICTION_FITTED     = 109418602; // largest exact count of the fit, the interval is extrapolated beyond it
+constexpr auto PREDICTION_TIME_SCALE = 0.44;      // solve seconds per state over the endgame cost, on those boards
+constexpr auto PREDICTION_PROBE_COST = 0.3;       // share of a state's time each further group read costs, e06 at --hash-bits 17 .. 23
+
+constexpr auto CANONICAL_HASH_BITS = 57; // canonical key = cell count (0..64) above a 57 bit board hash
+
+constexpr auto SHARED_NAME          = "/pop_star_8x8";
+constexpr auto SHARED_TABLE_BITS    = 24;  // 16M slots, 256 MB
+constexpr auto SHARED_TABLE_SIZE    = 1 << SHARED_TABLE_BITS;
+constexpr auto SHARED_PROBE_LIMIT   = 64;  // beyond that a state is explored without being recorded
+constexpr auto SHARED_TASK_CAPACITY = 4096;
+constexpr auto SHARED_SPLIT_DEPTH   = 3;   // moves expanded by the coordinator before handing out subtrees
+
 //constexpr auto THRESHOLD = ;
 
 
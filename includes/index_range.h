@@ -89,7 +89,7 @@ namespace index_range
     {
         auto new_begin_ = Container.begin();
         auto end_ = Container.end();
-        for ( auto i : Range( Amount.N ) )
+        for ( [[maybe_unused]] auto i : Range( Amount.N ) )
             if ( new_begin_ != end_ ) ++new_begin_;
         return ForwardRange( new_begin_, end_ );
     }
@@ -98,7 +98,7 @@ namespace index_range
     {
         auto new_begin_ = Container.begin();
         auto end_ = Container.end();
-        for ( auto i : Range( Amount.N ) )
+        for ( [[maybe_unused]] auto i : Range( Amount.N ) )
             if ( new_begin_ != end_ ) ++new_begin_;
         return ForwardRange( Container.begin(), new_begin_ );
     }
@@ -134,9 +134,46 @@ namespace sv
         }
     };
 
+    template <typename T, int Capacity_>
+    struct fixed_vector
+    {
+        constexpr static auto Capacity = Capacity_;
+
+        using SizeType = unsigned int;
+
+        SizeType Size = 0;
+        T Buffer[ Capacity ];  // left uninitialized, only [0,Size) is ever read
+
+        SizeType size() const { return Size; }
+
+        constexpr static SizeType capacity() { return Capacity; }
+
+        bool empty() const { return Size == 0; }
+
+        T* begin() const { return (T*)Buffer; }
+
+        T* end() const { return begin() + Size; }
+
+        T& operator[]( int n ) { return Buffer[ n ]; }
+
+        void push_back( T NewElement ) { Buffer[ Size++ ] = NewElement; } // caller guarantees Size < Capacity
+
+        void operator+=( T NewElement ) { push_back( NewElement ); }
+
+        void pop_back()
+        {
+            if ( Size ) --Size;
+        }
+
+        void erase_every( const T TargetValue )
+        {
+            Size -= end() - std::partition( begin(), end(), [ TargetValue ]( T Value ) { return Value != TargetValue; } );
+        }
+    };
+
     namespace debug
     {
-    
+
         template <typename T>
         void DumpBinary( T& src, int bytes = 1 )
         {
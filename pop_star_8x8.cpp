@@ -10,6 +10,23 @@
 #include <array>
 #include <mutex>
 #include <algorithm>
+#include <random>
+#include <unordered_set>
+#include <numeric>
+#include <cmath>
+#include <limits>
+#include <cstdlib>
+#include <utility>
+#include <bit>
+#include <span>
+#include <chrono>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 #include "includes/index_range.h"
 #include "includes/small_vector.h"
@@ -18,11 +35,14 @@
 
 
 using namespace std;
+using namespace std::chrono_literals;
 using namespace popstar;
 using namespace index_range;
 using sv::small_vector;
+using sv::fixed_vector;
 
 constexpr auto All = Range( MAX_x );
+constexpr auto Colours = Range( 1, int( TRIPLET_MASK ) );
 
 //****************************************************************************//
 //************************ Important Helper Function  ************************//
@@ -90,11 +110,29 @@ struct Future
 
 namespace Operational
 {
-    struct Puzzle
+    struct KeyMode // shared by every cell encoding, a board gets the same key whatever its bits per cell
+    {
+        inline static bool CanonicalKeys = false; // key by board content instead of KeepMap against MasterPuzzle
+
+        static int CountCell( const uint64_t Key ) { return CanonicalKeys ? Key >> CANONICAL_HASH_BITS : PopCount( Key ); }
+    };
+
+    template <int CellBits_>
+    struct BasicPuzzle : KeyMode
     {
-        static Puzzle MasterPuzzle;
+        constexpr static int CellBits = CellBits_;
+        constexpr static uint32_t CellMask = ( 1u << CellBits ) - 1;
+        constexpr static uint32_t LowBits = [] { // lowest bit of every cell in a column
+            uint32_t Bits = 0;
+            for ( auto y = 0; y < MAX_y; ++y ) Bits |= 1u << CellBits * y;
+            return Bits;
+        }();
+
+        using Cells = conditional_t<CellBits * MAX_y <= 16, uint16_t, uint32_t>;
 
-        uint32_t Column[ MAX_x ]{ 0 };
+        static BasicPuzzle MasterPuzzle;
+
+        Cells Column[ MAX_x ]{ 0 };
 
         union
         {
@@ -102,16 +140,16 @@ namespace Operational
             uint8_t KeepMap[ 8 ];
         };
                 
-        Puzzle() = default;
-        Puzzle(const Puzzle&) = default;
+        BasicPuzzle() = default;
+        BasicPuzzle(const BasicPuzzle&) = default;
 
         uint32_t at( uint32_t x, uint32_t y ) const
         {
             #ifdef _X86INTRIN_H_INCLUDED  //_BMIINTRIN_H_INCLUDED
-                return __bextr_u32( Column[ x ], BEXTR_SHIFT[ y ] );
-                // == _bextr_u32(Column[x],SHIFT[y],3); == bextr(_src, _start | _len(=3) << 8)
+                return __bextr_u32( Column[ x ], CellBits * y | CellBits << 8 );
+                // == _bextr_u32(Column[x],CellBits*y,CellBits); == bextr(_src, _start | _len << 8)
             #else
-                return Column[ x ] >> SHIFT[ y ] & TRIPLET_MASK;
+                return Column[ x ] >> CellBits * y & CellMask;
             #endif
         }
 
@@ -119,35 +157,28 @@ namespace Operational
 
         void Clear()
         {
-            memset( Column, 0, MAX_x * sizeof( uint32_t ) );
+            memset( Column, 0, sizeof( Column ) );
             Key = 0;
         }
 
-        void Clear( uint32_t x, uint32_t y ) { Column[ x ] &= ~TRI_MASK[ y ]; } // == TRI_MASK_FLIP[y]
-        void Fill( uint32_t x, uint32_t y ) { Column[ x ] |= TRI_MASK[ y ]; }
+        void Clear( uint32_t x, uint32_t y ) { Column[ x ] &= ~( CellMask << CellBits * y ); }
+        void Fill( uint32_t x, uint32_t y ) { Column[ x ] |= CellMask << CellBits * y; }
         void Fill( uint32_t x, uint32_t y, uint32_t value )
         {
             Clear( x, y );
-            Column[ x ] |= value << SHIFT[ y ];
-        }
-        
-        bool Linked( uint32_t x, uint32_t y ) const
-        {
-            if ( at( x, y ) == 0 ) return false;
-            if ( x == MAX_x - 1 )
-                 return at( x, y ) == at( x, y + 1 );
-            else return at( x, y ) == at( x, y + 1 ) || at( x, y ) == at( x + 1, y );
+            Column[ x ] |= value << CellBits * y;
         }
         
-        int CountCell() const { return PopCount( Key ); }
+        using KeyMode::CountCell;
+        int CountCell() const { return CountCell( Key ); }
 
-        Puzzle FloodFill( int x, int y )
+        BasicPuzzle FloodFill( int x, int y )
         {
-            Puzzle FootPrint;
+            BasicPuzzle FootPrint;
             struct
             {
-                Puzzle& FootPrint;
-                Puzzle& Target;
+                BasicPuzzle& FootPrint;
+                BasicPuzzle& Target;
                 uint32_t TargetColour;
                 void operator()( int x, int y )
                 {
@@ -166,26 +197,6 @@ namespace Operational
             return FootPrint;
         }
         
-        void FastFloodFill( int x, int y )
-        {
-            struct
-            {
-                Puzzle& Target;
-                uint32_t TargetColour;
-                void operator()( int x, int y )
-                {
-                    if ( x < 0 || x >= MAX_x || y < 0 || y >= MAX_y || TargetColour != Target( x, y ) )
-                        return;
-                    Target.Clear( x, y );
-                    ( *this )( x+1, y   );
-                    ( *this )( x-1, y   );
-                    ( *this )( x  , y+1 );
-                    ( *this )( x  , y-1 );
-                }
-            } RecursiveFloodFill{ *this, at( x, y ) };
-            RecursiveFloodFill( x, y );
-        }
-
         void ColumnShrink()
         {
             int space = 0;
@@ -200,7 +211,7 @@ namespace Operational
             }
         }
 
-        void Eliminate( const Puzzle& FloodFillFootPrint )
+        void Collapse( const BasicPuzzle& FloodFillFootPrint ) // Eliminate without refreshing Key
         {
             int x = 0;
             while ( !FloodFillFootPrint.Column[ x ] ) ++x;  //must be in range, so no boundary check
@@ -210,33 +221,28 @@ namespace Operational
                 ++x;
             }
             ColumnShrink();
-            Compress();
         }
 
-        auto Options() const
+        void Eliminate( const BasicPuzzle& FloodFillFootPrint )
         {
-            small_vector<Point,16> OptionList;
-            auto OptionPuzzle = *this;
-            for ( auto x : All ) 
-                for ( auto y : All )
-                    if ( OptionPuzzle.Linked( x, y ) )
-                    {
-                        OptionList += Point( x, y );
-                        OptionPuzzle.FastFloodFill( x, y );
-                    }
-            return OptionList;
+            Collapse( FloodFillFootPrint );
+            Compress();
         }
-        
-        uint64_t Compress()
+
+        auto Options() const; // see Groups
+
+        uint64_t Compress() { return Key = CanonicalKeys ? Canonical() : Relative(); }
+
+        uint64_t Relative() const
         {
             auto RetrieveKeepMap = []( const uint32_t MasterColumn, const uint32_t TargetColumn ) -> uint8_t
             {
-                if ( TargetColumn > 1 << SHIFT[ MAX_y - 1 ] )
+                if ( TargetColumn > 1u << CellBits * ( MAX_y - 1 ) )
                 {
                     if ( MasterColumn == TargetColumn ) return 0b11111111;
                     return 0; // full column but no match
                 }
-                auto at = []( const uint32_t Column, const int Pos ) { return __bextr_u32( Column, BEXTR_SHIFT[ Pos ] ); };
+                auto at = []( const uint32_t Column, const int Pos ) { return __bextr_u32( Column, CellBits * Pos | CellBits << 8 ); };
                 
                 for ( uint8_t Result = 0, y = 0; auto Master_y : All ) 
                 {
@@ -249,30 +255,204 @@ namespace Operational
                 return 0;
             };
             
-            Key = 0;
+            uint64_t Result = 0;
             for ( auto x = 0; auto Master_x : All ) 
             {
-                KeepMap[ x ] = RetrieveKeepMap( MasterPuzzle.Column[ Master_x ], Column[ x ] );
-                if ( KeepMap[ x ] != 0 ) ++x;
+                uint64_t KeepMap = RetrieveKeepMap( MasterPuzzle.Column[ Master_x ], Column[ x ] );
+                Result |= KeepMap << 8 * x;
+                if ( KeepMap != 0 ) ++x;
+            }
+            return Result;
+        }
+
+        uint64_t Canonical() const // master independent: colours renumbered by first appearance, cell count on top of a hash
+        {
+            uint8_t Palette[ CellMask + 1 ]{ 0 };
+            uint32_t NextColour = 0;
+            uint64_t Cells = 0;
+            uint64_t Hash = 0;
+            for ( auto x : All )
+            {
+                uint32_t Normalized = 0;
+                for ( auto y = 0; y < MAX_y && at( x, y ); ++y )
+                {
+                    auto& Colour = Palette[ at( x, y ) ];
+                    if ( !Colour ) Colour = ++NextColour;
+                    Normalized |= Colour << SHIFT[ y ]; // triplets whatever CellBits, so every encoding hashes alike
+                    ++Cells;
+                }
+                Hash = ( Hash ^ Normalized ) * 0x9E3779B97F4A7C15ull;
+                Hash ^= Hash >> 29;
+            }
+            Hash ^= Hash >> 32;
+            Hash *= 0xD6E8FEB86659FD93ull;
+            Hash ^= Hash >> 32;
+            return Cells << CANONICAL_HASH_BITS | Hash >> ( 64 - CANONICAL_HASH_BITS );
+        }
+
+    };
+
+    using Puzzle = BasicPuzzle<3>;       // layout of files, shared memory and every tool
+    using NarrowPuzzle = BasicPuzzle<2>; // 3 colours or fewer, picked by Narrowest
+
+    struct Groups // group labelling of one node, carried from parent to child, bit 8x+y stands for cell (x,y)
+    {
+        uint64_t Colour[ TRIPLET_MASK + 1 ]{ 0 };
+        fixed_vector<uint64_t, OPTION_CAPACITY> Members; // every group of 2+ cells, ordered by lowest cell
+
+        constexpr static uint64_t ColumnMask( int x ) { return 0xFFull << 8 * x; }
+        constexpr static uint64_t ColumnRange( int First, int Last ) // columns [First,Last] clipped to the board
+        {
+            First = std::max( First, 0 );
+            Last = std::min( Last, MAX_x - 1 );
+            if ( First > Last ) return 0;
+            return ( Last == MAX_x - 1 ? ~0ull : ( 1ull << 8 * ( Last + 1 ) ) - 1 ) & ~( ( 1ull << 8 * First ) - 1 );
+        }
+
+        static uint64_t Spread( const uint64_t Cells ) // every cell next to Cells
+        {
+            constexpr uint64_t NotBottom = ~0x0101010101010101ull, NotTop = ~0x8080808080808080ull;
+            return ( ( Cells << 1 ) & NotBottom ) | ( ( Cells >> 1 ) & NotTop ) | Cells << 8 | Cells >> 8;
+        }
+
+        static uint64_t Flood( uint64_t Seed, const uint64_t Within )
+        {
+            for ( uint64_t Previous = 0; Seed != Previous; )
+            {
+                Previous = Seed;
+                Seed |= Spread( Seed ) & Within;
+            }
+            return Seed;
+        }
+
+        static Point Representative( const uint64_t Member )
+        {
+            auto Cell = __builtin_ctzll( Member );
+            return Point( Cell / 8, Cell % 8 );
+        }
+
+        Groups() = default;
+
+        template <int CellBits>
+        explicit Groups( const BasicPuzzle<CellBits>& Board )
+        {
+            constexpr auto LowBits = BasicPuzzle<CellBits>::LowBits;
+            for ( auto x : All )
+                for ( auto c : Range( 1, int( BasicPuzzle<CellBits>::CellMask ) ) )
+                {
+                    const auto Difference = Board.Column[ x ] ^ c * LowBits;
+                    auto Differs = Difference;
+                    for ( auto Bit = 1; Bit < CellBits; ++Bit ) Differs |= Difference >> Bit;
+                    Colour[ c ] |= uint64_t( _pext_u32( ~Differs & LowBits, LowBits ) ) << 8 * x;
+                }
+            Label( ~0ull, 0 );
+        }
+
+        void Label( const uint64_t Region, const uint64_t Covered ) // add the groups through uncovered cells of Region
+        {
+            for ( auto SameColour : span( Colour ).subspan( 1 ) )
+            {
+                auto Within = SameColour & ~Covered;
+                for ( auto Candidates = Within & Spread( Within ) & Region; Candidates; ) // singletons never seed a flood
+                {
+                    const auto Member = Flood( Candidates & -Candidates, Within );
+                    Candidates &= ~Member;
+                    Within &= ~Member;
+
+                    auto Position = Members.end(); // keep Members ordered like a scan of the board
+                    for ( ; Position != Members.begin() && ( Position[ -1 ] & -Position[ -1 ] ) > ( Member & -Member ); --Position )
+                        *Position = Position[ -1 ];
+                    *Position = Member;
+                    ++Members.Size;
+                }
+            }
+        }
+
+        Groups After( const uint64_t Removed ) const // only columns around the popped ones are labelled again
+        {
+            const auto First = __builtin_ctzll( Removed ) / 8;
+            const auto Last = ( 63 - __builtin_clzll( Removed ) ) / 8;
+
+            Groups Child;
+            auto Survived = 0;
+            uint64_t Middle[ TRIPLET_MASK + 1 ]{ 0 };
+            for ( auto x = First; x <= Last; ++x )
+            {
+                const auto Keep = ~uint32_t( Removed >> 8 * x ) & 0xFF;
+                uint32_t Occupied = 0;
+                uint32_t Collapsed[ TRIPLET_MASK + 1 ];
+                for ( auto c : Colours )
+                    Occupied |= Collapsed[ c ] = _pext_u32( uint32_t( Colour[ c ] >> 8 * x ), Keep );
+                if ( !Occupied ) continue; // column emptied, the ones on its right move over
+                for ( auto c : Colours ) Middle[ c ] |= uint64_t( Collapsed[ c ] ) << 8 * Survived;
+                ++Survived;
+            }
+            const auto Shift = Last + 1 - First - Survived;
+
+            for ( auto c : Colours )
+                Child.Colour[ c ] = ( Colour[ c ] & ColumnRange( 0, First - 1 ) ) | Middle[ c ] << 8 * First  //
+                                  | ( Last + 1 < MAX_x ? Colour[ c ] >> 8 * ( Last + 1 ) << 8 * ( First + Survived ) : 0 );
+
+            const auto Dirty = ColumnRange( First - 1, Last + 1 );
+            uint64_t Covered = 0;
+            for ( auto Member : Members )
+            {
+                if ( Member & Dirty ) continue;
+                auto Carried = Member < ColumnMask( First ) ? Member : Member >> 8 * Shift;
+                Child.Members += Carried;
+                Covered |= Carried;
             }
-            return Key;
+            Child.Label( ColumnRange( First - 1, Last + 1 - Shift ), Covered );
+            return Child;
+        }
+
+        auto Options() const
+        {
+            fixed_vector<Point, OPTION_CAPACITY> OptionList;
+            for ( auto Member : Members ) OptionList += Representative( Member );
+            return OptionList;
         }
 
+        template <typename Board = Puzzle>
+        static Board FootPrint( const uint64_t Member ) // same as Puzzle::FloodFill from the representative
+        {
+            Board Result;
+            for ( auto x : All ) Result.Column[ x ] = _pdep_u32( uint32_t( Member >> 8 * x ) & 0xFF, Board::LowBits ) * Board::CellMask;
+            return Result;
+        }
+    };
+
+    template <int CellBits>
+    auto BasicPuzzle<CellBits>::Options() const { return Groups( *this ).Options(); }
+
+    struct Lineage // how a node was reached, its Groups get derived from the parent only once it is explored
+    {
+        constexpr static uint64_t Explored = 0; // no group is empty
+
+        const Groups* Parent = nullptr;
+        uint64_t Removed = 0;
+
+        template <typename Board>
+        Groups Resolve( const Board& Source ) const { return Parent ? Parent->After( Removed ) : Groups( Source ); }
     };
 
-    Puzzle Puzzle::MasterPuzzle;
+    template <int CellBits>
+    BasicPuzzle<CellBits> BasicPuzzle<CellBits>::MasterPuzzle;
     
-    void operator<<=( Puzzle& CurrentPuzzle, const Puzzle& FloodFillFootPrint )
+    template <int CellBits>
+    void operator<<=( BasicPuzzle<CellBits>& CurrentPuzzle, const BasicPuzzle<CellBits>& FloodFillFootPrint )
     {
         CurrentPuzzle.Eliminate( FloodFillFootPrint );
     }
 
-    void operator<<=( Puzzle& CurrentPuzzle, const Point CurrentMove )
+    template <int CellBits>
+    void operator<<=( BasicPuzzle<CellBits>& CurrentPuzzle, const Point CurrentMove )
     {
         CurrentPuzzle <<= CurrentPuzzle.FloodFill( CurrentMove.x, CurrentMove.y );
     }
     
-    auto operator<<( const Puzzle& CurrentPuzzle, const Point CurrentMove )
+    template <int CellBits>
+    auto operator<<( const BasicPuzzle<CellBits>& CurrentPuzzle, const Point CurrentMove )
     {
         auto ResultantPuzzle = CurrentPuzzle;
         ResultantPuzzle <<= CurrentMove;
@@ -296,6 +476,53 @@ namespace Operational
         }
     }
 
+    auto LoadAll( const char* FileName ) // every board in the file, separated by blank lines
+    {
+        vector<Puzzle> Puzzles;
+        ifstream Fin( FileName );
+        for ( string DataRow; Fin; )
+        {
+            Puzzle CurrentPuzzle;
+            auto y = MAX_y;
+            while ( y > 0 && getline( Fin, DataRow ) )
+            {
+                if ( DataRow.size() < MAX_x ) continue;
+                --y;
+                for ( auto x : All ) CurrentPuzzle.Fill( x, y, DataRow[ x ] - '0' );
+            }
+            if ( y > 0 ) break;
+            CurrentPuzzle.Compress();
+            Puzzles.push_back( CurrentPuzzle );
+        }
+        return Puzzles;
+    }
+
+    template <typename Target, typename Source>
+    Target Recode( const Source& Board ) // same board in another cell width, the key carries over unchanged
+    {
+        Target Result;
+        for ( auto x : All )
+            for ( auto y : All ) Result.Fill( x, y, Board( x, y ) );
+        Result.Key = Board.Key;
+        return Result;
+    }
+
+    template <typename Solver>
+    auto Narrowest( const Puzzle& Board, Solver&& Solve ) // hand Board to Solve in the narrowest encoding holding its colours
+    {
+        auto Highest = 0u;
+        auto Include = [ & ]( const Puzzle& Source ) {
+            for ( auto x : All )
+                for ( auto y : All ) Highest = max( Highest, Source( x, y ) );
+        };
+        Include( Board );
+        if ( !Puzzle::CanonicalKeys ) Include( Puzzle::MasterPuzzle ); // KeepMap children compare against it, so it must fit too
+        if ( Highest > NarrowPuzzle::CellMask ) return Solve( Board );
+
+        if ( !Puzzle::CanonicalKeys ) NarrowPuzzle::MasterPuzzle = Recode<NarrowPuzzle>( Puzzle::MasterPuzzle );
+        return Solve( Recode<NarrowPuzzle>( Board ) );
+    }
+
     ostream& operator<<( ostream& out, const Puzzle& CurrentPuzzle )
     {
         out << "Key: " <<setw(17)<< hex << uppercase  //
@@ -317,6 +544,8 @@ namespace Operational
 
 namespace Storage
 {
+    struct Table;
+
     struct Puzzle
     {
         Puzzle& operator=( const Puzzle& ) = delete;
@@ -325,35 +554,225 @@ namespace Storage
         
         Future BestFuture;
 
+        Score Lower{ Future::PendingScore }; // bounds proven by Decision::Probe, Bounds entries only
+        Score Upper{ numeric_limits<Score>::max() };
+
+        Puzzle() = default; // vacant slot of an overflow group
         Puzzle( uint64_t Key ) : Key{ Key }{}
 
-        int CountCell() const { return PopCount( Key ); }
+        int CountCell() const { return Operational::Puzzle::CountCell( Key ); }
 
-        using Bucket = vector<Storage::Puzzle>;
-        inline static array<Bucket, HASH_SIZE> Archive;
-        inline static array<mutex, PUZZLE_SIZE> DepthLock;
+        static Table Archive;
+        static Table Bounds;
+        inline static array<mutex, PUZZLE_SIZE + 1> DepthLock;
         
     };
+    static_assert( sizeof( Puzzle ) == 16 );
+
+    struct alignas( 64 ) Group // one cache line, fingerprints compared at once, entries inline so a hit reads nothing else
+    {
+        constexpr static auto Width = 3;
+        constexpr static uint8_t Vacant = 0, Busy = 1; // Tag() always sets the high bit, so neither matches a key
+
+        atomic<uint64_t> Tags{ 0 }; // byte i fingerprints Entry[ i ], Busy while its writer fills it in
+        Puzzle Entry[ Width ];
+        atomic<Group*> Overflow{ nullptr };
+
+        static uint32_t Match( const uint64_t Tags, const uint8_t Tag ) // bit i set when byte i equals Tag
+        {
+            auto Fingerprints = _mm_cvtsi64_si128( Tags );
+            return _mm_movemask_epi8( _mm_cmpeq_epi8( Fingerprints, _mm_set1_epi8( char( Tag ) ) ) ) & ( ( 1 << Width ) - 1 );
+        }
+        uint32_t Match( const uint8_t Tag ) const { return Match( Tags.load( memory_order_acquire ), Tag ); }
+    };
+    static_assert( sizeof( Group ) == 64 );
+
+    struct Table // 1 << Bits groups of anonymous memory, pages stay unmapped until a key lands in them
+    {
+        Group* Groups = nullptr;
+        int Bits = 0;
+
+        bool Reserve( const int NewBits )
+        {
+            if ( Groups ) munmap( Groups, Bytes() );
+            Bits = NewBits;
+            auto Memory = mmap( nullptr, Bytes(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+            Groups = Memory == MAP_FAILED ? nullptr : (Group*)Memory;
+            return Groups != nullptr;
+        }
+
+        void Clear() // anonymous pages read back as zero
+        {
+            if ( Groups ) madvise( Groups, Bytes(), MADV_DONTNEED );
+        }
+
+        size_t size() const { return size_t( 1 ) << Bits; }
+        size_t Bytes() const { return size() * sizeof( Group ); }
+        Group* begin() const { return Groups; }
+        Group* end() const { return Groups + size(); }
+        Group& operator[]( const uint64_t n ) const { return Groups[ n ]; }
+    };
+
+    inline Table Puzzle::Archive;
+    inline Table Puzzle::Bounds;
+
+    template <typename Node>
+    struct Arena // per thread supply of nodes, blocks outlive their thread until Release()
+    {
+        struct Block
+        {
+            Block* Next;
+            alignas( Node ) unsigned char Raw[ ARENA_BLOCK_SIZE * sizeof( Node ) ];
+        };
+
+        inline static atomic<Block*> Blocks{ nullptr };
+
+        Node* Cursor = nullptr;
+        Node* Limit  = nullptr;
 
-    auto Hash( const uint64_t Key ) { return Key % HASH_SIZE; }
+        template <typename... Arguments>
+        Node* New( Arguments... Values )
+        {
+            if ( Cursor == Limit ) Refill();
+            return new ( Cursor++ ) Node( Values... );
+        }
+
+        void Refill()
+        {
+            auto NewBlock = (Block*)aligned_alloc( alignof( Block ), sizeof( Block ) ); // once per ARENA_BLOCK_SIZE nodes, bypass operator new
+            NewBlock->Next = Blocks.load();
+            while ( !Blocks.compare_exchange_weak( NewBlock->Next, NewBlock ) ) {}
+            Cursor = (Node*)NewBlock->Raw;
+            Limit  = Cursor + ARENA_BLOCK_SIZE;
+        }
 
-    auto Match = []( const uint64_t Key ) {
-        return [ Key ]( const auto& Item ) { return Item.Key == Key; };
+        static void Release()
+        {
+            for ( auto CurrentBlock = Blocks.exchange( nullptr ); CurrentBlock; )
+                free( exchange( CurrentBlock, CurrentBlock->Next ) );
+        }
     };
 
-    bool Contains( uint64_t Key )
+    thread_local Arena<Group> LocalOverflow; // full groups chain into these, rare while the load stays moderate
+
+    bool Reserve( const int Bits ) // both tables, before any search
+    {
+        if ( Bits < 8 || Bits > 32 || !Puzzle::Archive.Reserve( Bits ) || !Puzzle::Bounds.Reserve( Bits ) )
+        {
+            cout << "Hash Index Unavailable: " << Bits << " bits" << endl;
+            return false;
+        }
+        return true;
+    }
+
+    int FittingBits( const double Entries ) // smallest table with a slot per entry, the mean probe stays about 1.2 even when full
+    {
+        auto Bits = 8;
+        while ( Bits < 32 && double( Group::Width ) * ( 1ull << Bits ) < Entries ) ++Bits;
+        return Bits;
+    }
+
+    double OverflowGroups( const double Entries, const int Bits ) // expected, homes filled at random hold a Poisson count each
+    {
+        const auto Homes = double( 1ull << Bits ), PerHome = Entries / Homes;
+        auto Probability = exp( -PerHome ), Expected = 0.0;
+        for ( auto k = 1; k < PerHome + 10 * sqrt( PerHome ) + 20; ++k )
+        {
+            Probability *= PerHome / k;
+            Expected += Probability * ( ( max( k - Group::Width, 0 ) + Group::Width - 1 ) / Group::Width );
+        }
+        return Homes * Expected;
+    }
+
+    double MeanProbe( const double Entries, const int Bits ) // expected groups read to find an entry, as CheckOccupancy counts them
+    {
+        const auto PerHome = Entries / double( 1ull << Bits );
+        auto Probability = exp( -PerHome ), Reads = 0.0, Held = 0.0;
+        for ( auto k = 1; k < PerHome + 10 * sqrt( PerHome ) + 20; ++k )
+        {
+            Probability *= PerHome / k;
+            Held += Probability * k;
+            for ( auto i : Range( k ) ) Reads += Probability * ( 1 + i / Group::Width );
+        }
+        return Held > 0 ? Reads / Held : 1;
+    }
+
+    void Release() // no thread may be exploring
+    {
+        Puzzle::Archive.Clear();
+        Puzzle::Bounds.Clear();
+        Arena<Group>::Release();
+    }
+
+    auto Hash( const uint64_t Key ) // keys are packed cells, low bits alone spread poorly
+    {
+        auto Mixed = Key * 0x9E3779B97F4A7C15ull;
+        Mixed ^= Mixed >> 32;
+        return Mixed * 0xD6E8FEB86659FD93ull;
+    }
+    auto Home( const uint64_t Mixed, const Table& Table ) { return &Table[ Mixed >> ( 64 - Table.Bits ) ]; }
+    uint8_t Tag( const uint64_t Mixed ) { return uint8_t( Mixed >> 16 ) | 0x80; } // below any index bit, high bit keeps it apart from vacant
+
+    Puzzle* Find( uint64_t Key, const Table& Table = Puzzle::Archive )
+    {
+        auto Mixed = Hash( Key );
+        auto Fingerprint = Tag( Mixed );
+        for ( auto Current = Home( Mixed, Table ); Current; Current = Current->Overflow.load( memory_order_acquire ) )
+            for ( auto Matches = Current->Match( Fingerprint ); Matches; Matches &= Matches - 1 )
+                if ( auto& Item = Current->Entry[ countr_zero( Matches ) ]; Item.Key == Key ) return &Item;
+        return nullptr; // an entry still Busy reads as absent, like the old bucket before its CAS
+    }
+
+    template <typename Visitor>
+    void ForEach( const Table& Table, Visitor&& Visit ) // Visit( Item, Probe ), Probe counts cache lines read to reach Item
+    {
+        for ( const auto& Home : Table )
+        {
+            auto Probe = 1;
+            for ( auto Current = &Home; Current; Current = Current->Overflow.load( memory_order_acquire ), ++Probe )
+                for ( auto Tags = Current->Tags.load( memory_order_acquire ); auto Slot : Range( Group::Width ) )
+                    if ( Tags >> 8 * Slot & 0x80 ) Visit( Current->Entry[ Slot ], Probe );
+        }
+    }
+
+    auto Count( const Table& Table = Puzzle::Archive )
+    {
+        auto Total = 0ull;
+        ForEach( Table, [ & ]( const Puzzle&, int ) { ++Total; } );
+        return Total;
+    }
+
+    bool Contains( uint64_t Key ) { return Find( Key ) != nullptr; }
+
+    Puzzle& Insert( uint64_t Key, Table& Table = Puzzle::Archive ) // no duplicate check, see RequireManage
     {
-        auto& Bucket = Puzzle::Archive[ Hash( Key ) ];
-        return any_of( rbegin( Bucket ), rend( Bucket ), Match( Key ) );
+        auto Mixed = Hash( Key );
+        auto Fingerprint = uint64_t( Tag( Mixed ) );
+        for ( auto Current = Home( Mixed, Table );; ) // other depths share this group
+        {
+            for ( auto Tags = Current->Tags.load( memory_order_relaxed ); auto Vacant = Group::Match( Tags, Group::Vacant ); )
+            {
+                const auto Slot = countr_zero( Vacant );
+                if ( !Current->Tags.compare_exchange_weak( Tags, Tags | uint64_t( Group::Busy ) << 8 * Slot, memory_order_relaxed ) ) continue;
+                auto NewItem = new ( &Current->Entry[ Slot ] ) Puzzle( Key );
+                Current->Tags.fetch_xor( ( Fingerprint ^ Group::Busy ) << 8 * Slot, memory_order_release ); // readers see it whole
+                return *NewItem;
+            }
+            auto Next = Current->Overflow.load( memory_order_acquire );
+            if ( !Next )
+            {
+                auto Extension = LocalOverflow.New();
+                if ( Current->Overflow.compare_exchange_strong( Next, Extension ) ) Next = Extension; // a lost race leaves Extension unused
+            }
+            Current = Next;
+        }
     }
 
     bool RequireManage( uint64_t Key )
     {
-        lock_guard Lock{ Puzzle::DepthLock[ PopCount( Key ) ] };
-        auto& Bucket = Puzzle::Archive[ Hash( Key ) ];
-        if ( any_of( rbegin( Bucket ), rend( Bucket ), Match( Key ) ) )
-            return false;
-        Bucket.emplace_back( Key );
+        lock_guard Lock{ Puzzle::DepthLock[ Operational::Puzzle::CountCell( Key ) ] };
+        if ( Contains( Key ) ) return false;
+        Insert( Key );
         return true;
     }
     bool Taken( uint64_t Key ) { return !RequireManage( Key ); }
@@ -361,10 +780,47 @@ namespace Storage
     struct {
         Puzzle& operator[]( const uint64_t Key ) // assume Storage::Contains(Key)
         {
-            auto& Bucket = Puzzle::Archive[ Hash( Key ) ];
-            return *find_if( rbegin( Bucket ), rend( Bucket ), Match( Key ) );
+            return *Find( Key );
         }
     } Proxy;
+
+    struct FrontCache // per thread, direct mapped, finished results only, ahead of Archive
+    {
+        struct Entry
+        {
+            uint64_t Key;
+            Future Result; // pending means vacant
+        };
+
+        array<Entry, 1 << FRONT_CACHE_BITS> Entries{};
+        unsigned long long Probes = 0, Hits = 0;
+
+        inline static atomic<unsigned long long> TotalProbes{ 0 }, TotalHits{ 0 };
+
+        static auto Index( const uint64_t Key ) { return Key * 0x9E3779B97F4A7C15ull >> ( 64 - FRONT_CACHE_BITS ); }
+
+        const Future* Find( const uint64_t Key )
+        {
+            ++Probes;
+            const auto& Slot = Entries[ Index( Key ) ];
+            if ( Slot.Key != Key || Slot.Result.BestScore == Future::PendingScore ) return nullptr;
+            ++Hits;
+            return &Slot.Result;
+        }
+
+        void Store( const uint64_t Key, const Future Result ) // caller writes Archive as well
+        {
+            if ( Result.BestScore != Future::PendingScore ) Entries[ Index( Key ) ] = { Key, Result };
+        }
+
+        void Flush() // counters into the run statistics
+        {
+            TotalProbes += exchange( Probes, 0 );
+            TotalHits += exchange( Hits, 0 );
+        }
+    };
+
+    thread_local FrontCache LocalCache; // entries stay valid until Release()
 }  // namespace Storage
 
 
@@ -372,68 +828,146 @@ namespace Storage
 //****************************** Major Function ******************************//
 //****************************************************************************//
 
-namespace ThisThread
+namespace AllocationHook
 {
-    auto Explore( const Operational::Puzzle& SourcePuzzle );
-}
+    thread_local bool Armed = false;
+    atomic<unsigned long long> Count{ 0 };
 
-auto ThisThread::Explore( const Operational::Puzzle& SourcePuzzle )
-{
-    Future ExplorationResult;
-    const auto BaselineCellCount = SourcePuzzle.CountCell();
-    const auto PuzzleKey = SourcePuzzle.Key;
+    inline void* Allocate( const size_t Size, const size_t Alignment ) noexcept // every replaced operator new lands here
+    {
+        if ( Armed ) ++Count;
+        if ( Alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ ) return malloc( Size ? Size : 1 );
+        return aligned_alloc( Alignment, ( max( Size, size_t( 1 ) ) + Alignment - 1 ) / Alignment * Alignment );
+    }
 
-    if ( Storage::Contains( PuzzleKey ) ||  //
-         Storage::Taken( PuzzleKey ) )      // do not change order, rely on short circuit
+    inline void* AllocateOrThrow( const size_t Size, const size_t Alignment )
     {
-        return Storage::Proxy[ PuzzleKey ].BestFuture.BestScore;
+        if ( auto Memory = Allocate( Size, Alignment ) ) return Memory;
+        throw bad_alloc();
     }
 
-    auto& RecordProxy = Storage::Proxy[ PuzzleKey ]; // obtain a proxy asap, reduce potential search time?
+    [[gnu::noinline]] void Free( void* Memory ) noexcept // out of line, inlined free next to operator new trips -Wmismatched-new-delete
+    {
+        free( Memory );
+    }
+}
+
+#ifdef ALLOCATION_HOOK // build with -DALLOCATION_HOOK to verify ThisThread::Explore never reaches operator new, run check_allocations.sh
+constexpr auto DefaultAlignment = size_t( __STDCPP_DEFAULT_NEW_ALIGNMENT__ );
+
+void* operator new( size_t Size ) { return AllocationHook::AllocateOrThrow( Size, DefaultAlignment ); }
+void* operator new[]( size_t Size ) { return AllocationHook::AllocateOrThrow( Size, DefaultAlignment ); }
+void* operator new( size_t Size, align_val_t Alignment ) { return AllocationHook::AllocateOrThrow( Size, size_t( Alignment ) ); }
+void* operator new[]( size_t Size, align_val_t Alignment ) { return AllocationHook::AllocateOrThrow( Size, size_t( Alignment ) ); }
+void* operator new( size_t Size, const nothrow_t& ) noexcept { return AllocationHook::Allocate( Size, DefaultAlignment ); }
+void* operator new[]( size_t Size, const nothrow_t& ) noexcept { return AllocationHook::Allocate( Size, DefaultAlignment ); }
+void* operator new( size_t Size, align_val_t Alignment, const nothrow_t& ) noexcept { return AllocationHook::Allocate( Size, size_t( Alignment ) ); }
+void* operator new[]( size_t Size, align_val_t Alignment, const nothrow_t& ) noexcept { return AllocationHook::Allocate( Size, size_t( Alignment ) ); }
+
+// malloc and aligned_alloc memory both go back through Free, so every delete form is the same
+void operator delete( void* Memory ) noexcept { AllocationHook::Free( Memory ); }
+void operator delete[]( void* Memory ) noexcept { AllocationHook::Free( Memory ); }
+void operator delete( void* Memory, size_t ) noexcept { AllocationHook::Free( Memory ); }
+void operator delete[]( void* Memory, size_t ) noexcept { AllocationHook::Free( Memory ); }
+void operator delete( void* Memory, align_val_t ) noexcept { AllocationHook::Free( Memory ); }
+void operator delete[]( void* Memory, align_val_t ) noexcept { AllocationHook::Free( Memory ); }
+void operator delete( void* Memory, size_t, align_val_t ) noexcept { AllocationHook::Free( Memory ); }
+void operator delete[]( void* Memory, size_t, align_val_t ) noexcept { AllocationHook::Free( Memory ); }
+void operator delete( void* Memory, const nothrow_t& ) noexcept { AllocationHook::Free( Memory ); }
+void operator delete[]( void* Memory, const nothrow_t& ) noexcept { AllocationHook::Free( Memory ); }
+void operator delete( void* Memory, align_val_t, const nothrow_t& ) noexcept { AllocationHook::Free( Memory ); }
+void operator delete[]( void* Memory, align_val_t, const nothrow_t& ) noexcept { AllocationHook::Free( Memory ); }
+#endif
+
+template<typename Board, typename Continuation> // shared option loop, Continuation( VariantPuzzle, Lineage ) yields a score or Future::PendingScore
+Future ExploreOptions( const Board& SourcePuzzle, const Operational::Lineage& From, Continuation&& Explore )
+{
+    Future ExplorationResult;
+    const auto SourceGroups = From.Resolve( SourcePuzzle );
 
-    if ( auto Options = SourcePuzzle.Options();  //
+    if ( auto Options = SourceGroups.Members;  //
          Options.empty() )
     {
-        ExplorationResult = Future( get_bonus_score( BaselineCellCount ), Future::NoMove );
+        ExplorationResult = Future( get_bonus_score( SourcePuzzle.CountCell() ), Future::NoMove );
     }
     else
     {
         while ( !Options.empty() )
         {
-            for ( auto& CurrentOption : Options )
+            for ( auto& CurrentMember : Options )
             {
-                auto VariantPuzzle = SourcePuzzle << CurrentOption;
-                auto VariantScore = ThisThread::Explore( VariantPuzzle );
+                auto VariantPuzzle = SourcePuzzle;
+                VariantPuzzle <<= Operational::Groups::FootPrint<Board>( CurrentMember );
+                Score VariantScore = Explore( VariantPuzzle, Operational::Lineage( &SourceGroups, CurrentMember ) );
                 if ( VariantScore != Future::PendingScore )
                 {
-                    VariantScore += get_score( BaselineCellCount - VariantPuzzle.CountCell() );
-                    ExplorationResult |=  Future( VariantScore, CurrentOption ) ;
-                    CurrentOption = Future::Explored;
+                    VariantScore += get_score( PopCount( CurrentMember ) );
+                    ExplorationResult |=  Future( VariantScore, Operational::Groups::Representative( CurrentMember ) ) ;
+                    CurrentMember = Operational::Lineage::Explored;
                 }
             }
-            Options.erase_every( Future::Explored );
+            Options.erase_every( Operational::Lineage::Explored );
         }
     }
+    return ExplorationResult;
+}
+
+namespace ThisThread
+{
+    template <typename Board>
+    Score Explore( const Board& SourcePuzzle, const Operational::Lineage& From = {} );
+}
+
+template <typename Board>
+Score ThisThread::Explore( const Board& SourcePuzzle, const Operational::Lineage& From )
+{
+    const auto PuzzleKey = SourcePuzzle.Key;
+
+    if ( auto Cached = Storage::LocalCache.Find( PuzzleKey ) ) return Cached->BestScore;
+
+    if ( Storage::Contains( PuzzleKey ) ||  //
+         Storage::Taken( PuzzleKey ) )      // do not change order, rely on short circuit
+    {
+        const auto Recorded = Storage::Proxy[ PuzzleKey ].BestFuture;
+        Storage::LocalCache.Store( PuzzleKey, Recorded );
+        return Recorded.BestScore;
+    }
+
+    auto& RecordProxy = Storage::Proxy[ PuzzleKey ]; // obtain a proxy asap, reduce potential search time?
+
+    auto ExplorationResult = ExploreOptions( SourcePuzzle, From, ThisThread::Explore<Board> );
     
-    RecordProxy.BestFuture = ExplorationResult;
+    RecordProxy.BestFuture = ExplorationResult; // write through
+    Storage::LocalCache.Store( PuzzleKey, ExplorationResult );
     return ExplorationResult.BestScore;
 }
 
-
-auto Explore( const Operational::Puzzle& SourcePuzzle )
+template <typename Board>
+auto Explore( const Board& SourcePuzzle )
 {
     Future ExplorationResult;
     const auto BaselineCellCount = SourcePuzzle.CountCell();
 
     atomic<int> AvailableThreads = THREAD_PERMISSION;
     mutex mtx;
-    for ( auto CurrentOption : SourcePuzzle.Options() ) 
+    const Operational::Groups RootGroups( SourcePuzzle );
+    for ( auto CurrentMember : RootGroups.Members ) 
     {
         while ( AvailableThreads <= 0 ) this_thread::yield();
         --AvailableThreads;
-        thread( [ & ] {
+        thread( [ &, CurrentMember ] {
+            const auto CurrentOption = Operational::Groups::Representative( CurrentMember );
+            const Operational::Lineage From( &RootGroups, CurrentMember );
             auto VariantPuzzle = SourcePuzzle << CurrentOption;
-            auto VariantScore = ThisThread::Explore( VariantPuzzle );
+            AllocationHook::Armed = true;
+            auto VariantScore = ThisThread::Explore( VariantPuzzle, From );
+            while ( VariantScore == Future::PendingScore ) // another root option got there first
+            {
+                this_thread::yield();
+                VariantScore = ThisThread::Explore( VariantPuzzle, From );
+            }
+            AllocationHook::Armed = false;
+            Storage::LocalCache.Flush();
             VariantScore += get_score( BaselineCellCount - VariantPuzzle.CountCell() );
             {
                 lock_guard Lock{ mtx };
@@ -448,53 +982,1139 @@ auto Explore( const Operational::Puzzle& SourcePuzzle )
 }
 
 //****************************************************************************//
+//*************************** Multi-Process Solving **************************//
 //****************************************************************************//
 
+namespace Shared // table and work queue living in shm_open memory, attached by every solver process
+{
+    constexpr uint64_t VacantKey = 0xFF00; // KeepMap packs nonzero bytes first, canonical keys of 0 cells hash the empty board
 
-//****************************************************************************//
-//****************************** Data Analysis  ******************************//
-//****************************************************************************//
+    struct Slot
+    {
+        atomic<uint64_t> Key;
+        atomic<uint32_t> Owner;   // pid claiming or exploring this state, set before Key and 0 once settled
+        atomic<uint32_t> Result;  // packed Future, 0 while pending
+
+        static uint32_t Pack( Future F ) { return uint32_t( F.BestScore + 1 ) << 8 | bit_cast<uint8_t>( F.BestMove ); }
+        static Future Unpack( uint32_t R )
+        {
+            if ( R == 0 ) return Future{};
+            return Future( Score( ( R >> 8 ) - 1 ), bit_cast<Point>( uint8_t( R ) ) );
+        }
+    };
+
+    struct Task
+    {
+        Operational::Puzzle State;
+        atomic<uint32_t> Owner;
+        atomic<bool> Finished;
+    };
+
+    struct Segment
+    {
+        uint32_t MasterColumn[ MAX_x ];
+        bool CanonicalKeys;
+        atomic<uint32_t> Coordinator; // pid of the creator, a dead one leaves the segment to be reclaimed
+        uint32_t TaskCount;
+        Task Tasks[ SHARED_TASK_CAPACITY ];
+        Slot Table[ SHARED_TABLE_SIZE ];
+    };
+
+    Segment* Attached = nullptr;
+    uint32_t Self = 0;
+
+    bool Alive( uint32_t Pid ) { return kill( Pid, 0 ) == 0 || errno == EPERM; }
+
+    auto Hash( const uint64_t Key ) { return Key * 0x9E3779B97F4A7C15ull >> ( 64 - SHARED_TABLE_BITS ); }
+
+    bool Map( const char* Name, bool Create )
+    {
+        auto Descriptor = shm_open( Name, Create ? O_CREAT | O_EXCL | O_RDWR : O_RDWR, 0600 );
+        if ( Descriptor < 0 )
+        {
+            if ( !Create || errno != EEXIST ) cout << "Shared Segment Unavailable: " << Name << endl;
+            return false;
+        }
+        if ( Create && ftruncate( Descriptor, sizeof( Segment ) ) != 0 )
+        {
+            close( Descriptor );
+            shm_unlink( Name );
+            cout << "Shared Segment Too Large: " << sizeof( Segment ) << endl;
+            return false;
+        }
+        auto Memory = mmap( nullptr, sizeof( Segment ), PROT_READ | PROT_WRITE, MAP_SHARED, Descriptor, 0 );
+        close( Descriptor );
+        if ( Memory == MAP_FAILED ) return false;
+        Attached = (Segment*)Memory;
+        Self = getpid();
+        if ( Create ) Attached->Coordinator = Self;
+        return true;
+    }
+
+    void Detach( const char* Name, bool Owner )
+    {
+        munmap( Attached, sizeof( Segment ) );
+        Attached = nullptr;
+        if ( Owner ) shm_unlink( Name );
+    }
+
+    bool Reclaim( const char* Name ) // O_EXCL found a segment, unlink it when its coordinator is gone
+    {
+        if ( !Map( Name, false ) ) return false;
+        auto Coordinator = Attached->Coordinator.load();
+        auto Stale = Coordinator == 0 || !Alive( Coordinator );
+        Detach( Name, Stale );
+        if ( Stale ) cout << "Stale Shared Segment Removed: " << Name << endl;
+        else cout << "Shared Segment In Use: " << Name << "  Coordinator: " << Coordinator << endl;
+        return Stale;
+    }
+
+    bool Create( const char* Name, const Operational::Puzzle& Root )
+    {
+        if ( !Map( Name, true ) && !( errno == EEXIST && Reclaim( Name ) && Map( Name, true ) ) ) return false;
+        for ( auto& CurrentSlot : Attached->Table ) CurrentSlot.Key = VacantKey;
+        memcpy( Attached->MasterColumn, Root.Column, sizeof( Root.Column ) );
+        Attached->CanonicalKeys = Operational::Puzzle::CanonicalKeys;
+
+        vector<Operational::Puzzle> Frontier{ Root };
+        for ( auto Depth = 0; Depth < SHARED_SPLIT_DEPTH; ++Depth )
+        {
+            vector<Operational::Puzzle> NextFrontier;
+            for ( auto& CurrentPuzzle : Frontier )
+                for ( auto CurrentOption : CurrentPuzzle.Options() )
+                    NextFrontier.push_back( CurrentPuzzle << CurrentOption );
+
+            auto ByKey = []( auto& lhs, auto& rhs ) { return lhs.Key < rhs.Key; };
+            auto SameKey = []( auto& lhs, auto& rhs ) { return lhs.Key == rhs.Key; };
+            sort( NextFrontier.begin(), NextFrontier.end(), ByKey );
+            NextFrontier.erase( unique( NextFrontier.begin(), NextFrontier.end(), SameKey ), NextFrontier.end() );
+
+            if ( NextFrontier.empty() || NextFrontier.size() > SHARED_TASK_CAPACITY ) break;
+            Frontier = move( NextFrontier );
+        }
+
+        for ( auto i = 0u; i < Frontier.size(); ++i ) Attached->Tasks[ i ].State = Frontier[ i ];
+        Attached->TaskCount = Frontier.size();
+        cout << "Shared Segment Created:\t[" << Name << "]  Tasks: " << Attached->TaskCount << '\n';
+        return true;
+    }
+
+    bool Attach( const char* Name )
+    {
+        if ( !Map( Name, false ) ) return false;
+        auto& MasterPuzzle = Operational::Puzzle::MasterPuzzle;
+        memcpy( MasterPuzzle.Column, Attached->MasterColumn, sizeof( MasterPuzzle.Column ) );
+        Operational::Puzzle::CanonicalKeys = Attached->CanonicalKeys;
+        MasterPuzzle.Compress();
+        return true;
+    }
+
+    pair<Slot*, bool> Claim( const uint64_t Key ) // { record, explore it here }, record is nullptr once the table is saturated
+    {
+        for ( auto Index = Hash( Key ); auto Probe : Range( SHARED_PROBE_LIMIT ) )
+        {
+            auto& CurrentSlot = Attached->Table[ ( Index + Probe ) & ( SHARED_TABLE_SIZE - 1 ) ];
+            auto Current = CurrentSlot.Key.load();
+            while ( Current == VacantKey ) // Owner goes in before Key, a claimer dying in between is still detected
+            {
+                auto Previous = CurrentSlot.Owner.load();
+                if ( Previous != 0 && Alive( Previous ) ) // claim in progress
+                {
+                    this_thread::yield();
+                    Current = CurrentSlot.Key.load();
+                    continue;
+                }
+                if ( !CurrentSlot.Owner.compare_exchange_strong( Previous, Self ) ) continue;
+                if ( CurrentSlot.Key.compare_exchange_strong( Current, Key ) ) return { &CurrentSlot, true };
+                CurrentSlot.Owner = Previous; // keyed meanwhile, Previous was its settled 0 or its dead explorer
+            }
+            if ( Current != Key ) continue;
+
+            if ( CurrentSlot.Result != 0 ) return { &CurrentSlot, false };
+            auto Owner = CurrentSlot.Owner.load();
+            if ( Owner != 0 && Owner != Self && !Alive( Owner ) &&  // crashed worker, take its subtree over
+                 CurrentSlot.Owner.compare_exchange_strong( Owner, Self ) )
+                return { &CurrentSlot, true };
+            return { &CurrentSlot, false };
+        }
+        return { nullptr, true };
+    }
+
+    Future Lookup( const uint64_t Key )
+    {
+        for ( auto Index = Hash( Key ); auto Probe : Range( SHARED_PROBE_LIMIT ) )
+        {
+            auto& CurrentSlot = Attached->Table[ ( Index + Probe ) & ( SHARED_TABLE_SIZE - 1 ) ];
+            if ( CurrentSlot.Key == Key ) return Slot::Unpack( CurrentSlot.Result );
+            if ( CurrentSlot.Key == VacantKey ) break;
+        }
+        return Future{};
+    }
 
-void CheckDistribution( const auto& HashTable, const int SamplingThreshold = 200 )
+    Score Explore( const Operational::Puzzle& SourcePuzzle, const Operational::Lineage& From = {} )
+    {
+        auto [ Record, Claimed ] = Claim( SourcePuzzle.Key );
+        if ( !Claimed ) return Slot::Unpack( Record->Result ).BestScore;
+
+        if ( !Record ) // table saturated around this key, memoise in this process instead
+        {
+            if ( auto Local = Storage::Find( SourcePuzzle.Key ) ) return Local->BestFuture.BestScore;
+            auto ExplorationResult = ExploreOptions( SourcePuzzle, From, Shared::Explore );
+            Storage::Insert( SourcePuzzle.Key ).BestFuture = ExplorationResult; // one thread per process, no DepthLock
+            return ExplorationResult.BestScore;
+        }
+
+        auto ExplorationResult = ExploreOptions( SourcePuzzle, From, Shared::Explore );
+        Record->Result = Slot::Pack( ExplorationResult );
+        Record->Owner = 0;
+        return ExplorationResult.BestScore;
+    }
+
+    void Work() // returns once every task is finished, by whichever process
+    {
+        for ( ;; )
+        {
+            auto Unfinished = 0;
+            for ( auto& CurrentTask : span( Attached->Tasks, Attached->TaskCount ) )
+            {
+                if ( CurrentTask.Finished ) continue;
+                ++Unfinished;
+                auto Owner = CurrentTask.Owner.load();
+                if ( Owner != 0 && ( Owner == Self || Alive( Owner ) ) ) continue;
+                if ( !CurrentTask.Owner.compare_exchange_strong( Owner, Self ) ) continue;
+
+                while ( Shared::Explore( CurrentTask.State ) == Future::PendingScore ) this_thread::yield();
+                CurrentTask.Finished = true;
+            }
+            if ( Unfinished == 0 ) return;
+            this_thread::sleep_for( 1ms );
+        }
+    }
+
+    Future Collect( const Operational::Puzzle& Root ) // every task settled, only the top SHARED_SPLIT_DEPTH moves remain
+    {
+        while ( Shared::Explore( Root ) == Future::PendingScore ) this_thread::yield();
+        if ( auto Local = Storage::Find( Root.Key ) ) return Local->BestFuture; // recorded here past the probe limit
+        return Lookup( Root.Key );
+    }
+}  // namespace Shared
+
+//****************************************************************************//
+//************************* Checkpoint And Resumption ************************//
+//****************************************************************************//
+
+namespace Checkpoint // settled Archive entries streamed to disk while the search keeps running
 {
-    auto max = [](auto a, auto b){ return std::max<unsigned long long>(a,b); };
-    auto min = [](auto a, auto b){ return std::min<unsigned long long>(a,b); };
-
-    constexpr auto BarWidthLimit = 120;
-    vector<int> BucketCount( SamplingThreshold + 2 );
-    auto Total = 0ull;
-    auto SpanMax = 0ull;
-    auto SpanMin = ~0ull;
-    
-    for( const auto& Bucket : HashTable )
+    struct Header
+    {
+        char Magic[ 4 ]{ 'P', 'S', 'C', 'K' };
+        uint32_t MasterColumn[ MAX_x ];
+        uint32_t CanonicalKeys;
+        uint64_t Count;
+    };
+
+    struct Record
+    {
+        uint64_t Key;
+        Future BestFuture;
+    };
+
+    atomic<bool> Stop = false;
+    volatile sig_atomic_t Preempted = 0;
+    thread Writer;
+
+    Header Describe( const Operational::Puzzle& Root )
+    {
+        Header CurrentHeader;
+        memcpy( CurrentHeader.MasterColumn, Root.Column, sizeof( Root.Column ) );
+        CurrentHeader.CanonicalKeys = Operational::Puzzle::CanonicalKeys;
+        CurrentHeader.Count = 0;
+        return CurrentHeader;
+    }
+
+    bool Write( const char* FileName, const Operational::Puzzle& Root ) // safe against concurrent inserts, pending entries left out
+    {
+        auto PartialName = string( FileName ) + ".partial";
+        ofstream Fout( PartialName, ios::binary );
+        auto CurrentHeader = Describe( Root );
+        Fout.write( (const char*)&CurrentHeader, sizeof( Header ) );
+
+        vector<Record> Buffer;
+        Buffer.reserve( 1 << 16 );
+        auto Flush = [ & ] {
+            Fout.write( (const char*)Buffer.data(), Buffer.size() * sizeof( Record ) );
+            CurrentHeader.Count += Buffer.size();
+            Buffer.clear();
+        };
+        Storage::ForEach( Storage::Puzzle::Archive, [ & ]( const Storage::Puzzle& Item, int ) {
+            auto BestFuture = Item.BestFuture;
+            if ( BestFuture.BestScore == Future::PendingScore ) return;
+            Buffer.push_back( Record( Item.Key, BestFuture ) );
+            if ( Buffer.size() == Buffer.capacity() ) Flush();
+        } );
+        Flush();
+
+        Fout.seekp( 0 );
+        Fout.write( (const char*)&CurrentHeader, sizeof( Header ) );
+        Fout.close();
+        if ( !Fout ) return false;
+        return rename( PartialName.c_str(), FileName ) == 0;
+    }
+
+    bool Read( const char* FileName, const Operational::Puzzle& Root ) // into an empty Archive
+    {
+        ifstream Fin( FileName, ios::binary );
+        if ( !Fin ) { cout << "Not Found: " << FileName << endl; return false; }
+
+        Header CurrentHeader;
+        auto Expected = Describe( Root );
+        Fin.read( (char*)&CurrentHeader, sizeof( Header ) );
+        if ( !Fin || memcmp( &CurrentHeader, &Expected, offsetof( Header, Count ) ) != 0 )
+        {
+            cout << "Checkpoint Mismatch: " << FileName << endl;
+            return false;
+        }
+
+        for ( Record CurrentRecord; Fin.read( (char*)&CurrentRecord, sizeof( Record ) ); )
+            Storage::Insert( CurrentRecord.Key ).BestFuture = CurrentRecord.BestFuture;
+
+        auto Finished = 0;
+        auto Options = Root.Options();
+        for ( auto CurrentOption : Options ) Finished += Storage::Contains( ( Root << CurrentOption ).Key );
+        cout << "Checkpoint Loaded:\t[" << FileName << "]  States: " << CurrentHeader.Count  //
+             << "  Root Options Finished: " << Finished << " / " << Options.size() << '\n';
+        return true;
+    }
+
+    void Start( const char* FileName, const Operational::Puzzle& Root, const chrono::seconds Interval )
+    {
+        signal( SIGTERM, []( int ) { Preempted = 1; } );
+        Writer = thread( [ = ] {
+            for ( ;; )
+            {
+                for ( auto Deadline = chrono::steady_clock::now() + Interval;  //
+                      chrono::steady_clock::now() < Deadline && !Stop && !Preempted; )
+                    this_thread::sleep_for( 100ms );
+                if ( Stop ) return;
+                auto Start = chrono::steady_clock::now();
+                auto Written = Write( FileName, Root );
+                cout << ( Written ? "Checkpoint Written: " : "Checkpoint Failed: " ) << FileName << "  "  //
+                     << chrono::duration_cast<chrono::milliseconds>( chrono::steady_clock::now() - Start ).count() << "ms" << endl;
+                if ( Preempted ) _exit( 128 + SIGTERM );
+            }
+        } );
+    }
+
+    void Finish( const char* FileName, const Operational::Puzzle& Root ) // final checkpoint makes a later --resume instant
+    {
+        if ( !Writer.joinable() ) return;
+        signal( SIGTERM, SIG_DFL ); // nothing acts on Preempted past this point, analysis and prompts end as usual
+        Stop = true;
+        Writer.join();
+        Write( FileName, Root );
+        if ( Preempted ) raise( SIGTERM ); // caught while the writer was winding down, honour it now the checkpoint is on disk
+    }
+}  // namespace Checkpoint
+
+//****************************************************************************//
+//*************************** Binary Puzzle Corpus ***************************//
+//****************************************************************************//
+
+namespace Corpus // boards kept in the packed Column[] triplet layout, read in place through mmap
+{
+    struct Header
+    {
+        char Magic[ 4 ]{ 'P', 'S', 'B', 'C' };
+        uint16_t Version{ 1 };
+        uint8_t Width{ MAX_x };
+        uint8_t Height{ MAX_y };
+        uint32_t Colours{ 0 };  // highest colour on any board
+        uint32_t Reserved{ 0 };
+        uint64_t Count{ 0 };
+        uint64_t IndexOffset{ 0 }; // Count board numbers ordered by content, after the boards, duplicates side by side
+    };
+
+    struct Board // same bits as Operational::Puzzle::Column, the key is left to the reader
+    {
+        uint32_t Column[ MAX_x ];
+
+        auto operator()( uint32_t x, uint32_t y ) const { return Column[ x ] >> SHIFT[ y ] & TRIPLET_MASK; }
+        auto operator<=>( const Board& ) const = default;
+    };
+
+    static_assert( sizeof( Header ) == 32 && sizeof( Board ) == 32 );
+
+    struct View // the whole file mapped read only, boards handed out without copying
+    {
+        const unsigned char* Base = nullptr;
+        size_t Length = 0;
+        span<const Board> Boards;
+        span<const uint32_t> Index;
+
+        View() = default;
+        View( const View& ) = delete;
+        ~View() { if ( Base ) munmap( (void*)Base, Length ); }
+
+        bool Open( const char* FileName )
+        {
+            auto Descriptor = open( FileName, O_RDONLY );
+            if ( Descriptor < 0 ) { cout << "Not Found: " << FileName << endl; return false; }
+            Length = lseek( Descriptor, 0, SEEK_END );
+            auto Memory = Length >= sizeof( Header ) ? mmap( nullptr, Length, PROT_READ, MAP_SHARED, Descriptor, 0 ) : MAP_FAILED;
+            close( Descriptor );
+            if ( Memory == MAP_FAILED ) { cout << "Corpus Mismatch: " << FileName << endl; return false; }
+            Base = (const unsigned char*)Memory;
+
+            const auto& CurrentHeader = *(const Header*)Base;
+            const Header Expected;
+            const auto Count = CurrentHeader.Count, IndexOffset = CurrentHeader.IndexOffset; // bounded by division first, so no product wraps
+            auto Valid = memcmp( &CurrentHeader, &Expected, offsetof( Header, Colours ) ) == 0 &&  //
+                         Count <= ( Length - sizeof( Header ) ) / sizeof( Board ) &&
+                         IndexOffset >= sizeof( Header ) + Count * sizeof( Board ) && IndexOffset <= Length &&
+                         IndexOffset % alignof( uint32_t ) == 0 && Count <= ( Length - IndexOffset ) / sizeof( uint32_t );
+            if ( Valid )
+            {
+                Boards = { (const Board*)( Base + sizeof( Header ) ), Count };
+                Index = { (const uint32_t*)( Base + IndexOffset ), Count };
+                Valid = all_of( Index.begin(), Index.end(), [ & ]( const uint32_t n ) { return n < Count; } ); // main indexes Boards with them
+            }
+            if ( !Valid )
+            {
+                Boards = {};
+                Index = {};
+                cout << "Corpus Mismatch: " << FileName << endl;
+                return false;
+            }
+            cout << "Corpus loaded:\t[" << FileName << "]  Boards: " << Boards.size() << "  Colours: " << CurrentHeader.Colours << '\n';
+            return true;
+        }
+
+        auto size() const { return Boards.size(); }
+        auto begin() const { return Boards.begin(); }
+        auto end() const { return Boards.end(); }
+        const Board& operator[]( size_t n ) const { return Boards[ n ]; }
+    };
+
+    bool Write( const char* FileName, const vector<Board>& Boards )
+    {
+        Header CurrentHeader;
+        CurrentHeader.Count = Boards.size();
+        CurrentHeader.IndexOffset = sizeof( Header ) + Boards.size() * sizeof( Board );
+        for ( auto& CurrentBoard : Boards )
+            for ( auto x : All )
+                for ( auto y : All ) CurrentHeader.Colours = max( CurrentHeader.Colours, CurrentBoard( x, y ) );
+
+        vector<uint32_t> Index( Boards.size() );
+        iota( Index.begin(), Index.end(), 0 );
+        stable_sort( Index.begin(), Index.end(), [ & ]( uint32_t lhs, uint32_t rhs ) { return Boards[ lhs ] < Boards[ rhs ]; } );
+
+        auto PartialName = string( FileName ) + ".partial";
+        ofstream Fout( PartialName, ios::binary );
+        Fout.write( (const char*)&CurrentHeader, sizeof( Header ) );
+        Fout.write( (const char*)Boards.data(), Boards.size() * sizeof( Board ) );
+        Fout.write( (const char*)Index.data(), Index.size() * sizeof( uint32_t ) );
+        Fout.close();
+        if ( !Fout ) return false;
+        return rename( PartialName.c_str(), FileName ) == 0;
+    }
+
+    int Convert( const char* FileName ) // every board of a text file, as read by LoadAll, into FileName.bin
+    {
+        if ( !ifstream( FileName ) ) { cout << "Not Found: " << FileName << endl; return 1; }
+        vector<Board> Boards;
+        for ( auto& CurrentPuzzle : Operational::LoadAll( FileName ) )
+        {
+            Board CurrentBoard;
+            memcpy( CurrentBoard.Column, CurrentPuzzle.Column, sizeof( CurrentBoard.Column ) );
+            Boards.push_back( CurrentBoard );
+        }
+        if ( Boards.empty() ) { cout << "No Boards: " << FileName << endl; return 1; }
+        auto BinaryName = string( FileName ) + ".bin";
+        if ( !Write( BinaryName.c_str(), Boards ) ) { cout << "Cannot Write: " << BinaryName << endl; return 1; }
+        cout << "Corpus written:\t[" << BinaryName << "]  Boards: " << Boards.size() << '\n';
+        return 0;
+    }
+}  // namespace Corpus
+
+void operator<<( Operational::Puzzle& CurrentPuzzle, const Corpus::Board& Source )
+{
+    memcpy( CurrentPuzzle.Column, Source.Column, sizeof( Source.Column ) );
+    CurrentPuzzle.Compress();
+}
+
+//****************************************************************************//
+//***************************** Batch Verification ***************************//
+//****************************************************************************//
+
+namespace Verification // exact scoring of submitted move sequences, no search involved
+{
+    using MoveList = vector<Point>;
+
+    struct Verdict
+    {
+        Score Total{ 0 };
+        int Applied{ 0 };       // moves played before the sequence ended or turned illegal
+        bool Legal{ true };     // false at the first move off the board, on an empty cell or on a singleton
+        bool Complete{ false }; // no group left afterwards, bonus included in Total
+    };
+
+    struct Progress // one step of a sequence, kept per depth so sorted neighbours can share their prefix
+    {
+        Operational::Puzzle Board;
+        Score Total;
+        int CellCount;
+    };
+
+    bool Play( Progress& Current, const Point Move, Progress& Next )
+    {
+        auto& Board = Current.Board;
+        auto x = Move.x, y = Move.y;
+        if ( x >= MAX_x || y >= MAX_y ) return false;
+        auto Colour = Board( x, y );
+        if ( Colour == 0 ) return false;
+        if ( !( ( y + 1 < MAX_y && Board( x, y + 1 ) == Colour ) || ( y > 0 && Board( x, y - 1 ) == Colour ) ||  //
+                ( x + 1 < MAX_x && Board( x + 1, y ) == Colour ) || ( x > 0 && Board( x - 1, y ) == Colour ) ) )
+            return false;
+
+        Next.Board = Board;
+        auto FootPrint = Next.Board.FloodFill( x, y );
+        auto Removed = 0;
+        for ( auto FootPrintColumn : FootPrint.Column ) Removed += __builtin_popcount( FootPrintColumn );
+        Removed /= Operational::Puzzle::CellBits;
+        Next.Board.Collapse( FootPrint );
+        Next.CellCount = Current.CellCount - Removed;
+        Next.Total = Current.Total + get_score( Removed );
+        return true;
+    }
+
+    void Conclude( Verdict& Result, const Progress& Last )
+    {
+        Result.Total = Last.Total;
+        Result.Complete = Result.Legal && Last.Board.Options().empty();
+        if ( Result.Complete ) Result.Total += get_bonus_score( Last.CellCount );
+    }
+
+    int CountCell( const Operational::Puzzle& Board )
+    {
+        auto Cells = 0;
+        for ( auto x : All )
+            for ( auto y : All ) Cells += Board( x, y ) != 0;
+        return Cells;
+    }
+
+    Verdict Verify( const Operational::Puzzle& Board, const MoveList& Moves )
+    {
+        Progress Steps[ 2 ]{ { Board, 0, CountCell( Board ) } };
+        Verdict Result;
+        for ( auto Move : Moves )
+        {
+            if ( !Play( Steps[ Result.Applied % 2 ], Move, Steps[ ( Result.Applied + 1 ) % 2 ] ) )
+            {
+                Result.Legal = false;
+                break;
+            }
+            ++Result.Applied;
+        }
+        Conclude( Result, Steps[ Result.Applied % 2 ] );
+        return Result;
+    }
+
+    auto VerifyBatch( const Operational::Puzzle& Board, const vector<MoveList>& Sequences, unsigned ThreadCount = thread::hardware_concurrency() )
+    {
+        auto Key = []( Point P ) { return bit_cast<uint8_t>( P ); };
+        vector<uint32_t> Order( Sequences.size() );
+        for ( auto i : Range( Order.size() ) ) Order[ i ] = i;
+        sort( Order.begin(), Order.end(), [ & ]( auto lhs, auto rhs ) {
+            return lexicographical_compare( Sequences[ lhs ].begin(), Sequences[ lhs ].end(),  //
+                                            Sequences[ rhs ].begin(), Sequences[ rhs ].end(),  //
+                                            [ & ]( Point a, Point b ) { return Key( a ) < Key( b ); } );
+        } );
+
+        vector<Verdict> Results( Sequences.size() );
+        atomic<unsigned long long> Played = 0;
+        auto Worker = [ & ]( size_t First, size_t Last )
+        {
+            Progress Steps[ PUZZLE_SIZE / 2 + 1 ]{ { Board, 0, CountCell( Board ) } };
+            const MoveList* Previous = nullptr;
+            auto Valid = 0; // Steps[ 0 .. Valid ] describe a prefix of *Previous
+            auto LocalPlayed = 0ull;
+            for ( auto Index : span( Order ).subspan( First, Last - First ) )
+            {
+                auto& Moves = Sequences[ Index ];
+                auto Depth = 0;
+                if ( Previous )
+                    while ( Depth < Valid && Depth < (int)Moves.size() && Key( Moves[ Depth ] ) == Key( ( *Previous )[ Depth ] ) ) ++Depth;
+
+                auto& Result = Results[ Index ];
+                for ( ; Depth < (int)Moves.size(); ++Depth, ++LocalPlayed )
+                    if ( Depth == PUZZLE_SIZE / 2 || !Play( Steps[ Depth ], Moves[ Depth ], Steps[ Depth + 1 ] ) )
+                    {
+                        Result.Legal = false;
+                        break;
+                    }
+                Result.Applied = Depth;
+                Conclude( Result, Steps[ Depth ] );
+
+                Previous = &Moves;
+                Valid = Depth;
+            }
+            Played += LocalPlayed;
+        };
+
+        ThreadCount = max( 1u, ThreadCount );
+        vector<thread> Workers;
+        for ( auto Chunk : Range( ThreadCount ) )
+            Workers.emplace_back( Worker, Order.size() * Chunk / ThreadCount, Order.size() * ( Chunk + 1 ) / ThreadCount );
+        for ( auto& CurrentWorker : Workers ) CurrentWorker.join();
+        return pair{ Results, Played.load() };
+    }
+
+    auto Load( const char* FileName ) // one sequence per line, every move two digits "xy", anything else ignored
+    {
+        vector<MoveList> Sequences;
+        ifstream Fin( FileName );
+        if ( !Fin ) cout << "Not Found: " << FileName << endl;
+        for ( string Line; getline( Fin, Line ); )
+        {
+            MoveList Moves;
+            int Pending = -1;
+            for ( auto Character : Line )
+            {
+                if ( Character < '0' || Character > '9' ) continue;
+                if ( Pending < 0 ) Pending = Character - '0';
+                else
+                {
+                    Moves.push_back( Point( Pending, Character - '0' ) );
+                    Pending = -1;
+                }
+            }
+            Sequences.push_back( move( Moves ) );
+        }
+        return Sequences;
+    }
+
+    int Run( const Operational::Puzzle& Board, const char* FileName ) // results go to FileName.scored, one line per sequence
+    {
+        auto Sequences = Load( FileName );
+        auto Total = 0ull;
+        for ( auto& Moves : Sequences ) Total += Moves.size();
+
+        auto Start = chrono::steady_clock::now();
+        auto [ Results, Played ] = VerifyBatch( Board, Sequences );
+        auto Elapsed = chrono::duration<double>( chrono::steady_clock::now() - Start ).count();
+
+        ofstream Fout( string( FileName ) + ".scored" );
+        for ( auto& Result : Results )
+            Fout << Result.Total << ' ' << Result.Applied << ' '  //
+                 << ( !Result.Legal ? "illegal" : Result.Complete ? "complete" : "incomplete" ) << '\n';
+
+        cout << "[ Verification ]  \tSequences : " << Sequences.size() << "  Moves : " << Total  //
+             << "  Played : " << Played << "  Time : " << Elapsed << "s  Moves/s : " << Played / max( Elapsed, 1e-9 ) << '\n';
+        return Fout ? 0 : 1;
+    }
+}  // namespace Verification
+
+//****************************************************************************//
+//***************************** Threshold Decision ***************************//
+//****************************************************************************//
+
+namespace Decision // "can this board reach Target?", fail-soft null window search over the same move generation
+{
+    unsigned long long Probes = 0;
+
+    Score Optimistic( const Operational::Groups& Current ) // every colour popped as one group, fewest cells left behind
+    {
+        Score Bound = 0;
+        auto Singletons = 0;
+        for ( auto SameColour : span( Current.Colour ).subspan( 1 ) )
+            if ( auto n = PopCount( SameColour ); n == 1 ) ++Singletons;
+            else Bound += get_score( n ); // 5n^2 is superadditive, one pop beats any split
+        return Bound + get_bonus_score( Singletons );
+    }
+
+    // result >= Target proves the board reaches at least result, result < Target proves it cannot exceed result
+    Score Probe( const Operational::Puzzle& SourcePuzzle, const Operational::Lineage& From, const Score Target )
+    {
+        ++Probes;
+        const auto PuzzleKey = SourcePuzzle.Key;
+
+        if ( auto Settled = Storage::Find( PuzzleKey ); Settled && Settled->BestFuture.BestScore != Future::PendingScore )
+            return Settled->BestFuture.BestScore; // exact value left by Explore
+
+        auto Bounds = Storage::Find( PuzzleKey, Storage::Puzzle::Bounds );
+        if ( Bounds && Bounds->Lower >= Target ) return Bounds->Lower;
+        if ( Bounds && Bounds->Upper < Target ) return Bounds->Upper;
+        if ( !Bounds ) Bounds = &Storage::Insert( PuzzleKey, Storage::Puzzle::Bounds );
+
+        const auto SourceGroups = From.Resolve( SourcePuzzle );
+
+        if ( SourceGroups.Members.empty() )
+            return Bounds->Lower = Bounds->Upper = get_bonus_score( SourcePuzzle.CountCell() );
+
+        if ( auto Bound = Optimistic( SourceGroups ); Bound < Target ) return Bounds->Upper = min( Bounds->Upper, Bound );
+
+        auto Options = SourceGroups.Members; // largest group first, it usually reaches Target soonest
+        sort( Options.begin(), Options.end(), []( auto a, auto b ) { return PopCount( a ) > PopCount( b ); } );
+
+        Score Best = numeric_limits<Score>::min();
+        for ( auto CurrentMember : Options )
+        {
+            const auto Gain = get_score( PopCount( CurrentMember ) );
+            auto VariantPuzzle = SourcePuzzle;
+            VariantPuzzle <<= Operational::Groups::FootPrint( CurrentMember );
+            Best = max<Score>( Best, Gain + Probe( VariantPuzzle, Operational::Lineage( &SourceGroups, CurrentMember ), Target - Gain ) );
+            if ( Best >= Target ) return Bounds->Lower = max( Bounds->Lower, Best );
+        }
+        return Bounds->Upper = min( Bounds->Upper, Best );
+    }
+
+    bool Reaches( const Operational::Puzzle& SourcePuzzle, const Score Target ) { return Probe( SourcePuzzle, {}, Target ) >= Target; }
+
+    Score Greedy( Operational::Puzzle SourcePuzzle ) // largest group every turn, a reachable first guess
+    {
+        Score Total = 0;
+        for ( Operational::Groups Current( SourcePuzzle ); !Current.Members.empty(); )
+        {
+            auto Largest = *max_element( Current.Members.begin(), Current.Members.end(),  //
+                                         []( auto a, auto b ) { return PopCount( a ) < PopCount( b ); } );
+            Total += get_score( PopCount( Largest ) );
+            SourcePuzzle <<= Operational::Groups::FootPrint( Largest );
+            Current = Current.After( Largest );
+        }
+        return Total + get_bonus_score( SourcePuzzle.CountCell() );
+    }
+
+    Score Value( const Operational::Puzzle& SourcePuzzle, int& Passes ) // MTD(f), null window probes until the bounds meet
+    {
+        Score Guess = Greedy( SourcePuzzle );
+        Score Lower = Future::PendingScore, Upper = numeric_limits<Score>::max();
+        for ( Passes = 0; Lower < Upper; ++Passes )
+        {
+            const Score Target = Guess == Lower ? Guess + 1 : Guess;
+            Guess = Probe( SourcePuzzle, {}, Target );
+            if ( Guess < Target ) Upper = Guess;
+            else Lower = Guess;
+        }
+        return Guess;
+    }
+
+    int Run( const Operational::Puzzle& SourcePuzzle, const char* Target ) // --reach S, or the exact value when Target is null
+    {
+        auto Start = chrono::steady_clock::now();
+        auto Passes = 1;
+        auto Result = Target ? Probe( SourcePuzzle, {}, Score( atoi( Target ) ) ) : Value( SourcePuzzle, Passes );
+        auto Elapsed = chrono::duration<double>( chrono::steady_clock::now() - Start ).count();
+
+        auto Population = Storage::Count( Storage::Puzzle::Bounds );
+
+        if ( Target ) cout << "Reach " << Target << ": " << ( Result >= atoi( Target ) ? "yes, at least " : "no, at most " ) << Result << '\n';
+        else cout << "Final Score: " << Result << '\n';
+        cout << "[ Decision ]  \tPasses : " << Passes << "  Probes : " << Probes << "  States : " << Population  //
+             << "  Time : " << Elapsed << "s\n";
+        Storage::Release();
+        return 0;
+    }
+}  // namespace Decision
+
+//****************************************************************************//
+//*************************** Solve Cost Prediction **************************//
+//****************************************************************************//
+
+namespace Prediction // Knuth's estimator over the state DAG, each step divided by an in-degree found among path moves, then calibrated
+{
+    using Operational::Groups;
+
+    struct Origin // a state is the set of original cells still on the board, a move the original cells it pops
+    {
+        uint64_t Colour[ TRIPLET_MASK + 1 ]{ 0 };
+        uint64_t Occupied = 0;
+
+        explicit Origin( const Groups& Root )
+        {
+            for ( auto c : Colours ) Occupied |= Colour[ c ] = Root.Colour[ c ];
+        }
+
+        static uint64_t ToLayout( const uint64_t Cells, const uint64_t Remaining ) // where Cells sit once gravity settles
+        {
+            uint64_t Result = 0;
+            for ( auto Survived = 0; auto x : All )
+                if ( const auto Keep = uint32_t( Remaining >> 8 * x ) & 0xFF )
+                    Result |= uint64_t( _pext_u32( uint32_t( Cells >> 8 * x ) & 0xFF, Keep ) ) << 8 * Survived++;
+            return Result;
+        }
+
+        static uint64_t ToOrigin( const uint64_t Cells, const uint64_t Remaining )
+        {
+            uint64_t Result = 0;
+            for ( auto Survived = 0; auto x : All )
+                if ( const auto Keep = uint32_t( Remaining >> 8 * x ) & 0xFF )
+                    Result |= uint64_t( _pdep_u32( uint32_t( Cells >> 8 * Survived++ ) & 0xFF, Keep ) ) << 8 * x;
+            return Result;
+        }
+
+        Groups Layout( const uint64_t Remaining ) const
+        {
+            Groups Result;
+            for ( auto c : Colours ) Result.Colour[ c ] = ToLayout( Colour[ c ] & Remaining, Remaining );
+            Result.Label( ~0ull, 0 );
+            return Result;
+        }
+
+        int ColourOf( const uint64_t Cells ) const
+        {
+            for ( auto c : Colours )
+                if ( Colour[ c ] & Cells ) return c;
+            return 0;
+        }
+    };
+
+    struct Sampler
+    {
+        const Origin& Board;
+        mt19937_64 Random;
+        vector<uint64_t> Path;         // moves of the current descent
+        unordered_set<uint64_t> Failed; // states proven unable to pop exactly the target
+        int Budget = 0;
+
+        unsigned long long Steps = 0;
+        vector<double> Totals; // one state count estimate per descent
+
+        bool Reachable( const uint64_t Remaining, const uint64_t Target ) // pop exactly Target from Remaining, moves of early path steps first
+        {
+            if ( !Target ) return true;
+            if ( --Budget < 0 || Failed.contains( Remaining ) ) return false;
+
+            fixed_vector<pair<int, uint64_t>, OPTION_CAPACITY> Inside;
+            for ( auto Member : Board.Layout( Remaining ).Members )
+                if ( auto Popped = Origin::ToOrigin( Member, Remaining ); !( Popped & ~Target ) )
+                {
+                    auto Step = 0;
+                    while ( !( Path[ Step ] & Popped ) ) ++Step;
+                    Inside += { Step, Popped };
+                }
+            sort( Inside.begin(), Inside.end() );
+
+            for ( auto [ Step, Popped ] : Inside )
+                if ( Reachable( Remaining & ~Popped, Target & ~Popped ) ) return true;
+            Failed.insert( Remaining );
+            return false;
+        }
+
+        int InDegree( const uint64_t Remaining ) // parents found among path moves popped last, alone or merged in pairs
+        {
+            fixed_vector<uint64_t, PUZZLE_SIZE * 2> Candidates;
+            auto Regroup = [ & ]( const uint64_t Moves ) // Moves put back on the board, each group they form is a candidate
+            {
+                const auto Parent = Remaining | Moves;
+                const auto Same = Origin::ToLayout( Board.Colour[ Board.ColourOf( Moves ) ] & Parent, Parent );
+                const auto Restored = Origin::ToLayout( Moves, Parent );
+                for ( auto Seeds = Restored; Seeds; )
+                {
+                    const auto Member = Groups::Flood( Seeds & -Seeds, Same );
+                    Seeds &= ~Member;
+                    if ( Member == ( Member & Restored ) && PopCount( Member ) > 1 && Candidates.size() < Candidates.capacity() )
+                        Candidates += Origin::ToOrigin( Member, Parent );
+                }
+            };
+            for ( auto i : Range( int( Path.size() ) ) )
+            {
+                Regroup( Path[ i ] );
+                for ( auto j : Range( i + 1, int( Path.size() ) - 1 ) )
+                    if ( Board.ColourOf( Path[ i ] ) == Board.ColourOf( Path[ j ] ) ) Regroup( Path[ i ] | Path[ j ] );
+            }
+            sort( Candidates.begin(), Candidates.end() );
+
+            auto Parents = 0;
+            const auto Removed = Board.Occupied & ~Remaining;
+            for ( auto Candidate = Candidates.begin(); Candidate != Candidates.end(); ++Candidate )
+            {
+                if ( Candidate != Candidates.begin() && Candidate[ -1 ] == *Candidate ) continue;
+                const auto Parent = Remaining | *Candidate; // regrouped in a layout with more cells restored, so recheck it
+                const auto ParentGroups = Board.Layout( Parent );
+                if ( find( ParentGroups.Members.begin(), ParentGroups.Members.end(), Origin::ToLayout( *Candidate, Parent ) ) == ParentGroups.Members.end() )
+                    continue;
+                Failed.clear();
+                Budget = PREDICTION_BUDGET;
+                Parents += Reachable( Board.Occupied, Removed & ~*Candidate ); // giving up counts as no parent, Run calibrates the lean
+            }
+            return max( Parents, 1 );
+        }
+
+        void Descend()
+        {
+            Path.clear();
+            auto Remaining = Board.Occupied;
+            auto Current = Board.Layout( Remaining );
+            double Weight = 1, Total = 1;
+            while ( !Current.Members.empty() )
+            {
+                const auto Branching = Current.Members.size();
+                const auto Member = Current.Members[ Random() % Branching ];
+                Path.push_back( Origin::ToOrigin( Member, Remaining ) );
+                Remaining &= ~Path.back();
+                Current = Current.After( Member );
+                Weight *= double( Branching ) / InDegree( Remaining );
+                Total += Weight;
+                ++Steps;
+            }
+            Totals.push_back( Total );
+        }
+    };
+
+    double SecondsPerState( const Operational::Puzzle& Root ) // solve a few small endgames with ThisThread::Explore on this machine
+    {
+        auto Start = chrono::steady_clock::now();
+        thread( [ & ] { // own thread, so no arena cursor outlives the Release below
+            mt19937_64 Random( 1 );
+            for ( auto Endgame = 0; Endgame < 32; ++Endgame )
+            {
+                auto CurrentPuzzle = Root;
+                for ( auto Options = CurrentPuzzle.Options(); !Options.empty() && CurrentPuzzle.CountCell() > PUZZLE_SIZE / 2;
+                      Options = CurrentPuzzle.Options() )
+                    CurrentPuzzle <<= Options[ Random() % Options.size() ];
+                ThisThread::Explore( CurrentPuzzle );
+            }
+        } ).join();
+        auto Elapsed = chrono::duration<double>( chrono::steady_clock::now() - Start ).count();
+        auto Settled = Storage::Count();
+        Storage::Release();
+        return Elapsed / max( Settled, 1ull );
+    }
+
+    struct Estimate // calibrated by PREDICTION_FIT
+    {
+        double States, Lower, Upper; // point estimate and its 95% interval
+        double Mean, Median;         // of the raw descents
+        double Depth, Sampling;      // moves per descent, seconds spent
+        int Present;                 // colours on the board
+    };
+
+    Estimate Predict( const Groups& RootGroups, const int Samples ) // Samples > 0
     {
-        auto BucketSize = Bucket.size();
-        Total += BucketSize;
-        SpanMax = max( SpanMax, BucketSize );
-        SpanMin = min( SpanMin, BucketSize );
-        ++BucketCount[ min( BucketSize, SamplingThreshold + 1 ) ];
+        const Origin Board( RootGroups );
+        const auto Threads = max( thread::hardware_concurrency(), 1u );
+
+        auto Start = chrono::steady_clock::now();
+        vector<Sampler> Samplers;
+        for ( auto Index : Range( Threads ) ) Samplers.push_back( Sampler{ Board, mt19937_64( Index + 1 ), {}, {}, 0, 0, {} } );
+        vector<thread> Workers;
+        for ( auto Index : Range( Threads ) )
+            Workers.emplace_back( [ &, Index ] {
+                for ( auto Sample = Index; Sample < unsigned( Samples ); Sample += Threads ) Samplers[ Index ].Descend();
+            } );
+        for ( auto& Worker : Workers ) Worker.join();
+        auto Sampling = chrono::duration<double>( chrono::steady_clock::now() - Start ).count();
+
+        vector<double> Totals;
+        auto Steps = 0ull;
+        for ( auto& Each : Samplers )
+        {
+            Totals.insert( Totals.end(), Each.Totals.begin(), Each.Totals.end() );
+            Steps += Each.Steps;
+        }
+
+        auto Present = 0;
+        for ( auto c : Colours ) Present += RootGroups.Colour[ c ] != 0;
+
+        // missed parents push the mean high on crowded boards and heavy tails pull it low on sparse ones, so the count
+        // comes from PREDICTION_FIT and the 95% interval from its leave-one-out spread, not from the sampling spread
+        const auto Mean = accumulate( Totals.begin(), Totals.end(), 0.0 ) / Samples;
+        nth_element( Totals.begin(), Totals.begin() + Samples / 2, Totals.end() );
+        const auto Median = Totals[ Samples / 2 ];
+        const auto [ Intercept, MeanSlope, MedianSlope, ColourSlope ] = PREDICTION_FIT;
+        const auto States = exp( Intercept + MeanSlope * log( Mean ) + MedianSlope * log( Median ) + ColourSlope * Present );
+        const auto Lower = States / exp( 1.96 * PREDICTION_SPREAD ), Upper = States * exp( 1.96 * PREDICTION_SPREAD );
+        return { States, Lower, Upper, Mean, Median, double( Steps ) / Samples, Sampling, Present };
     }
-    auto TruncatedSpanMax = min( SpanMax, SamplingThreshold );
 
-    //Normalization
-    auto BucketCountMax = 0ull;
-    auto BucketCountMin = ~0ull;
-    for ( auto BucketSize : Range( SpanMin, SpanMax ) )
+    int TableBits( const Operational::Puzzle& Root, const bool Report = true ) // table of a solve, fitted to the point estimate
     {
-        auto BucketCountNow = BucketCount[ BucketSize ];
-        BucketCountMax = max( BucketCountMax, BucketCountNow );
-        BucketCountMin = min( BucketCountMin, BucketCountNow );
+        auto Predicted = Predict( Groups( Root ), PREDICTION_SIZING ); // the 95% interval stays under load 2.3
+        if ( Storage::FittingBits( Predicted.States ) >= PREDICTION_REFINE_BITS ) Predicted = Predict( Groups( Root ), atoi( PREDICTION_SAMPLES ) );
+        const auto Bits = Storage::FittingBits( Predicted.States );
+        if ( Report ) cout << "Predicted States : " << llround( Predicted.States ) << "  Hash Bits : " << Bits << "  ( --hash-bits N overrides )\n";
+        return Bits;
     }
 
-    auto Scale = [ = ]( auto Orginal ) { return Orginal * BarWidthLimit / ( BucketCountMax - BucketCountMin + 1 ); };
+    int Run( const Operational::Puzzle& Root, const int Samples, const int SolveBits ) // SolveBits 0 when the solve sizes its own table
+    {
+        if ( Samples < 1 )
+        {
+            cout << "No Samples\n";
+            return 1;
+        }
+        const Groups RootGroups( Root );
+        const auto Threads = max( thread::hardware_concurrency(), 1u );
+        const auto [ States, Lower, Upper, Mean, Median, Depth, Sampling, Present ] = Predict( RootGroups, Samples );
+
+        auto Average = 0.0;
+        for ( auto Member : RootGroups.Members ) Average += PopCount( Member );
+        Average /= max( int( RootGroups.Members.size() ), 1 );
+
+        const auto Bits = SolveBits ? SolveBits : TableBits( Root, false ); // the table main would reserve
+        auto Memory = [ & ]( double Count ) // table plus the overflow groups its entries spill into
+        {
+            return double( sizeof( Storage::Group ) ) * ( ( 1ull << Bits ) + Storage::OverflowGroups( Count, Bits ) ) / ( 1 << 20 );
+        };
+        if ( !Storage::Reserve( atoi( HASH_BITS ) ) ) return 1; // endgames only
+        const auto Cost = SecondsPerState( Root ) / min<unsigned>( Threads, THREAD_PERMISSION );
+        auto Seconds = [ & ]( double Count ) // endgame cost scaled to whole solves, plus the chains Count entries grow in the table
+        {
+            return Count * Cost * PREDICTION_TIME_SCALE * ( 1 + PREDICTION_PROBE_COST * ( Storage::MeanProbe( Count, Bits ) - 1 ) );
+        };
+
+        cout << fixed << setprecision( 1 );
+        cout << "[ Prediction ]  \tColours : " << Present << "  Groups : " << RootGroups.Members.size()  //
+             << "  Group Size : " << Average << "  Depth : " << Depth << '\n';
+        cout << "States : " << setprecision( 0 ) << States << "  95% : " << Lower << " .. " << Upper  //
+             << "  Mean : " << Mean << "  Median : " << Median << '\n';
+        cout << "Memory : " << setprecision( 1 ) << Memory( States ) << " MB  95% : " << Memory( Lower ) << " .. " << Memory( Upper ) << " MB\n";
+        cout << "Time   : " << setprecision( 2 ) << Seconds( States ) << " s  at the 95% bounds : " << Seconds( Lower ) << " .. " << Seconds( Upper ) << " s\n";
+        cout << "Hash Bits : " << Bits << "  Mean Probe : " << Storage::MeanProbe( States, Bits ) << "  Endgame Cost : " << Cost * 1e6  //
+             << " us per state  Samples : " << Samples << "  Sampling : " << Sampling << " s\n";
+        if ( Samples != atoi( PREDICTION_SAMPLES ) ) cout << "Interval fitted at " << PREDICTION_SAMPLES << " samples, other counts shift it.\n";
+        if ( States > PREDICTION_FITTED )
+            cout << "Beyond the largest board of the fit, " << PREDICTION_FITTED << " states, the interval is extrapolated.\n";
+        return 0;
+    }
+}  // namespace Prediction
+
+//****************************************************************************//
+//****************************************************************************//
+
+
+//****************************************************************************//
+//****************************** Data Analysis  ******************************//
+//****************************************************************************//
+
+void CheckOccupancy( const Storage::Table& Table )
+{
+    auto Entries = 0ull, Overflows = 0ull, TotalProbe = 0ull;
+    auto MaxProbe = 0;
+    Storage::ForEach( Table, [ & ]( const Storage::Puzzle&, int Probe ) {
+        ++Entries;
+        TotalProbe += Probe;
+        MaxProbe = max( MaxProbe, Probe );
+    } );
+    for ( const auto& Home : Table )
+        for ( auto Current = Home.Overflow.load(); Current; Current = Current->Overflow.load() ) ++Overflows;
+
+    cout << "[ Hash Index ]  \tEntries : " << Entries << "  Load : " << 100.0 * Entries / ( Table.size() * Storage::Group::Width ) << "%"  //
+         << "  Overflow Groups : " << Overflows << "  Mean Probe : " << double( TotalProbe ) / max( Entries, 1ull )         //
+         << "  Max Probe : " << MaxProbe << '\n';
+    if ( auto Bits = Storage::FittingBits( Entries ); Bits > Table.Bits ) cout << "Index overloaded, rerun with --hash-bits " << Bits << '\n';
+}
+
+template <typename RecallFunction> // RecallFunction( Puzzle ) yields the settled Future of a state
+void AnalyseRoot( const Operational::Puzzle& Root, const int Depth, RecallFunction&& Recall, const char* FileName )
+{
+    ofstream Fout( FileName ); // one line per line of play: exact total score, then its moves as xy pairs
+    auto Lines = 0ull;
+    auto Walk = [ & ]( auto& Self, const Operational::Puzzle& Current, string& Moves, const Score Gained, const int Remaining ) -> void
+    {
+        const Operational::Groups CurrentGroups( Current );
+        for ( auto Member : CurrentGroups.Members )
+        {
+            auto Next = Current;
+            Next <<= Operational::Groups::FootPrint( Member );
+            auto Value = Recall( Next ).BestScore;
+            if ( Value == Future::PendingScore ) Value = ThisThread::Explore( Next ); // left out of a full shared table
+            const auto Reached = Gained + get_score( PopCount( Member ) );
+            const auto Move = Operational::Groups::Representative( Member );
+
+            const auto Length = Moves.size();
+            Moves += { ' ', char( '0' + Move.x ), char( '0' + Move.y ) };
+            Fout << Reached + Value << Moves << '\n';
+            ++Lines;
+            if ( Remaining == Depth ) cout << Move << "  " << Reached + Value << '\n';
+            if ( Remaining > 1 ) Self( Self, Next, Moves, Reached, Remaining - 1 );
+            Moves.resize( Length );
+        }
+    };
+
+    cout << "[ Root Analysis ]  \tDepth : " << Depth << '\n';
+    string Moves;
+    Walk( Walk, Root, Moves, 0, max( Depth, 1 ) );
+    cout << "Lines : " << Lines << "  Written : " << FileName << '\n';
+}
+
+void MeasureKeys( const Operational::Puzzle& Root, const int Descents = 20000 )
+{
+    mt19937 Random( 1 );
+    vector<Operational::Puzzle> Samples;
+    for ( auto Descent = 0; Descent < Descents; ++Descent )
+        for ( auto CurrentPuzzle = Root; ; )
+        {
+            auto Options = CurrentPuzzle.Options();
+            if ( Options.empty() ) break;
+            CurrentPuzzle <<= Options[ Random() % Options.size() ];
+            Samples.push_back( CurrentPuzzle );
+        }
+
+    using Board = array<uint32_t, MAX_x>;
+    auto AsIs = []( const Operational::Puzzle& P )
+    {
+        Board Columns;
+        for ( auto x : Range( MAX_x ) ) Columns[ x ] = P.Column[ x ];
+        return Columns;
+    };
+    auto Recoloured = []( const Operational::Puzzle& P ) // colours renumbered by first appearance, equal for colour permutations
+    {
+        using Operational::Puzzle;
+        Board Columns{};
+        uint32_t Palette[ Puzzle::CellMask + 1 ]{ 0 };
+        uint32_t NextColour = 0;
+        for ( auto x : Range( MAX_x ) )
+            for ( auto y : Range( MAX_y ) )
+                if ( auto Cell = P.Column[ x ] >> Puzzle::CellBits * y & Puzzle::CellMask )
+                {
+                    if ( Palette[ Cell ] == 0 ) Palette[ Cell ] = ++NextColour;
+                    Columns[ x ] |= Palette[ Cell ] << Puzzle::CellBits * y;
+                }
+        return Columns;
+    };
+
+    auto Measure = [ & ]( const char* Name, auto KeyOf, auto Identity ) // Identity tells boards a key may merge apart
+    {
+        vector<uint64_t> Keys( Samples.size() );
+        auto Start = chrono::steady_clock::now();
+        for ( auto i : Range( int( Samples.size() ) ) ) Keys[ i ] = KeyOf( Samples[ i ] );
+        auto Elapsed = chrono::duration<double, nano>( chrono::steady_clock::now() - Start ).count();
+
+        vector<pair<uint64_t, Board>> Entries;
+        for ( auto i : Range( int( Samples.size() ) ) ) Entries.emplace_back( Keys[ i ], Identity( Samples[ i ] ) );
+        sort( Entries.begin(), Entries.end() );
+        Entries.erase( unique( Entries.begin(), Entries.end() ), Entries.end() );
+        auto Colliding = 0ull; // boards sharing their key with a different board
+        for ( auto First = Entries.begin(); First != Entries.end(); )
+        {
+            auto Last = find_if( First, Entries.end(), [ & ]( auto& Entry ) { return Entry.first != First->first; } );
+            if ( Last - First > 1 ) Colliding += Last - First;
+            First = Last;
+        }
+
+        sort( Keys.begin(), Keys.end() );
+        auto Distinct = unique( Keys.begin(), Keys.end() ) - Keys.begin();
+        cout << setw( 12 ) << Name << " :  8 bytes  " << setw( 6 ) << fixed << setprecision( 1 )  //
+             << Elapsed / Samples.size() << " ns/key  Distinct: " << Distinct << "  Colliding Boards: " << Colliding << '\n';
+        return Colliding;
+    };
 
-    cout << "[ Bucket Size Distruibution ]  \t";
-    cout <<  "Total : " << Total << "  Max : " << SpanMax << "  Min : " << SpanMin <<'\n';
-    for ( auto BucketSize : Range( SpanMin, TruncatedSpanMax ) )
-        cout << setw( 4 ) << BucketSize << " : "                                         //
-             << setfill( '|' ) << setw( 1 + Scale( BucketCount[ BucketSize ] ) ) << ' '  //
-             << setfill( ' ' ) << BucketCount[ BucketSize ] << '\n';
-    cout << " >" << SamplingThreshold << " :  " << BucketCount[ SamplingThreshold + 1 ] << '\n';    
+    auto ByBoard = []( auto& lhs, auto& rhs ) { return memcmp( lhs.Column, rhs.Column, sizeof( lhs.Column ) ) < 0; };
+    auto SameBoard = []( auto& lhs, auto& rhs ) { return memcmp( lhs.Column, rhs.Column, sizeof( lhs.Column ) ) == 0; };
+    auto Boards = Samples;
+    sort( Boards.begin(), Boards.end(), ByBoard );
+    auto DistinctBoards = unique( Boards.begin(), Boards.end(), SameBoard ) - Boards.begin();
+
+    cout << "[ Key Comparison ]  \tSamples : " << Samples.size() << "  Distinct Boards : " << DistinctBoards  //
+         << "  Packed Board : " << PUZZLE_SIZE * 3 / 8 << " bytes\n";
+    auto KeepMapCollisions = Measure( "KeepMap", []( const auto& P ) { return P.Relative(); }, AsIs );
+    Measure( "Canonical", []( const auto& P ) { return P.Canonical(); }, Recoloured );
+    cout << "Colliding boards share a memo entry, so one of them is scored with the other's result.\n"
+            "Canonical only counts hash collisions here, colour permutations of one board share their score.\n";
+    if ( KeepMapCollisions )
+        cout << "KeepMap keys collide on this board, a key byte does not record which master column it matched.\n"
+                "Its scores may be wrong, solve it with --canonical.\n";
 }
 
 //****************************************************************************//
@@ -504,18 +2124,148 @@ int main( int argc, const char* argv[] )
 {
     auto& MasterPuzzle = Operational::Puzzle::MasterPuzzle;
 
-    MasterPuzzle << PUZZLE_PATH;
+    auto Option = [ & ]( const char* Flag, const char* Default ) -> const char*  // nullptr when Flag is absent
+    {
+        for ( auto i : Range( 1, argc - 1 ) )
+            if ( strcmp( argv[ i ], Flag ) == 0 )
+                return i + 1 < argc && argv[ i + 1 ][ 0 ] != '-' ? argv[ i + 1 ] : Default;
+        return nullptr;
+    };
+
+    const auto HashBits = Option( "--hash-bits", HASH_BITS ); // absent, a solve sizes the table from its predicted state count
+
+    if ( auto SharedName = Option( "--worker", SHARED_NAME ) )
+    {
+        if ( !Storage::Reserve( atoi( HashBits ? HashBits : HASH_BITS ) ) || !Shared::Attach( SharedName ) ) return 1;
+        Shared::Work();
+        Shared::Detach( SharedName, false );
+        return 0;
+    }
 
-    for ( auto& Bucket : Storage::Puzzle::Archive ) Bucket.reserve( 200 );
-    cout << "Allocation Complete\n";
+    if ( auto TextFile = Option( "--convert", PUZZLE_PATH ) ) return Corpus::Convert( TextFile );
+
+    Operational::Puzzle::CanonicalKeys = Option( "--canonical", "" ) != nullptr;
+
+    Corpus::View Boards;
+    const auto CorpusFile = Option( "--corpus", nullptr );
+    const auto BoardOption = Option( "--board", "0" );
+    const auto Chosen = BoardOption ? atoi( BoardOption ) : 0;
+    if ( CorpusFile )
+    {
+        if ( !Boards.Open( CorpusFile ) ) return 1;
+        if ( Chosen < 0 || Chosen >= int( Boards.size() ) )
+        {
+            cout << "Board Out Of Range: " << Chosen << "  Boards: " << Boards.size() << endl;
+            return 1;
+        }
+        MasterPuzzle << Boards[ Chosen ];
+    }
+    else MasterPuzzle << PUZZLE_PATH;
+
+    if ( !Operational::Puzzle::CanonicalKeys && Verification::CountCell( MasterPuzzle ) < PUZZLE_SIZE )
+    {
+        cout << "Board has empty cells, KeepMap keys would miscount them, solving with --canonical.\n";
+        Operational::Puzzle::CanonicalKeys = true; // before Narrowest and any table records a key
+        MasterPuzzle.Compress();
+    }
 
     cout << MasterPuzzle << endl;
 
-    auto ExplorationResult = Explore( MasterPuzzle );
+    if ( auto MoveFile = Option( "--verify", nullptr ) ) return Verification::Run( MasterPuzzle, MoveFile );
+
+    if ( auto Samples = Option( "--predict", PREDICTION_SAMPLES ) )
+        return Prediction::Run( MasterPuzzle, atoi( Samples ), HashBits ? atoi( HashBits ) : 0 );
+
+    if ( Option( "--measure-keys", "" ) )
+    {
+        MeasureKeys( MasterPuzzle );
+        return 0;
+    }
+
+    if ( !Storage::Reserve( HashBits ? atoi( HashBits ) : Prediction::TableBits( MasterPuzzle ) ) ) return 1;
+
+    if ( auto Target = Option( "--reach", nullptr ) ) return Decision::Run( MasterPuzzle, Target );
+    if ( Option( "--mtdf", "" ) ) return Decision::Run( MasterPuzzle, nullptr );
+
+    const auto SharedName = Option( "--shared", SHARED_NAME );
+    const auto Processes  = Option( "--processes", "1" );
+
+    Future ExplorationResult;
+    if ( SharedName || Processes )
+    {
+        if ( !Shared::Create( SharedName ? SharedName : SHARED_NAME, MasterPuzzle ) ) return 1;
+        signal( SIGCHLD, SIG_IGN ); // auto reap, so a crashed worker no longer looks alive
+        cout << flush;
+        for ( auto Worker = 1; Worker < atoi( Processes ? Processes : "1" ); ++Worker )
+            if ( fork() == 0 )
+            {
+                Shared::Self = getpid();
+                Shared::Work();
+                _exit( 0 );
+            }
+        Shared::Work();
+        ExplorationResult = Shared::Collect( MasterPuzzle );
+    }
+    else
+    {
+        if ( Option( "--resume", "" ) && !Checkpoint::Read( CHECKPOINT_PATH, MasterPuzzle ) ) return 1;
+        if ( auto Interval = Option( "--checkpoint", CHECKPOINT_INTERVAL ) )
+            Checkpoint::Start( CHECKPOINT_PATH, MasterPuzzle, chrono::seconds( atoi( Interval ) ) );
+
+        ExplorationResult = Operational::Narrowest( MasterPuzzle, []( const auto& Board ) { return Explore( Board ); } );
+
+        if ( Operational::Puzzle::CanonicalKeys ) // further boards in the file reuse every state already settled
+        {
+            auto Population = Storage::Count();
+            cout << "\nStates: " << Population << '\n';
+            auto SolveRelated = [ & ]( const Operational::Puzzle& RelatedPuzzle )
+            {
+                auto RelatedResult = Operational::Narrowest( RelatedPuzzle, []( const auto& Board ) { return Explore( Board ); } );
+                auto NewPopulation = Storage::Count();
+                cout << "Related Puzzle Score: " << RelatedResult.BestScore << "  New States: " << NewPopulation - Population << '\n';
+                Population = NewPopulation;
+            };
+            if ( CorpusFile )
+                for ( const Corpus::Board* Previous = nullptr; auto n : Boards.Index ) // content order, every board solved once
+                {
+                    auto Repeated = ( Previous && Boards[ n ] == *Previous ) || Boards[ n ] == Boards[ Chosen ];
+                    Previous = &Boards[ n ];
+                    if ( Repeated ) continue;
+                    Operational::Puzzle RelatedPuzzle;
+                    RelatedPuzzle << Boards[ n ];
+                    SolveRelated( RelatedPuzzle );
+                }
+            else
+            {
+                auto RelatedPuzzles = Operational::LoadAll( PUZZLE_PATH );
+                for ( auto& RelatedPuzzle : RelatedPuzzles | Drop( 1 ) ) SolveRelated( RelatedPuzzle );
+            }
+        }
+
+        Checkpoint::Finish( CHECKPOINT_PATH, MasterPuzzle );
+    }
+
+    auto Recall = [ & ]( const Operational::Puzzle& CurrentPuzzle )
+    {
+        if ( Shared::Attached ) return Shared::Collect( CurrentPuzzle ); // settled elsewhere, or here past the probe limit
+        if ( !Storage::Contains( CurrentPuzzle.Key ) ) ThisThread::Explore( CurrentPuzzle ); // may be missing from a resumed checkpoint
+        return Storage::Proxy[ CurrentPuzzle.Key ].BestFuture;
+    };
 
     cout << "\nFinal Score: " << ExplorationResult.BestScore << endl;
 
-    CheckDistribution( Storage::Puzzle::Archive );
+    if ( auto Depth = Option( "--analyse", "1" ) ) AnalyseRoot( MasterPuzzle, atoi( Depth ), Recall, ANALYSIS_PATH );
+
+    #ifdef ALLOCATION_HOOK
+        cout << "Hot Path Allocations: " << AllocationHook::Count << endl;
+        if ( AllocationHook::Count ) return 1;
+    #endif
+
+    if ( auto Probes = Storage::FrontCache::TotalProbes.load() )
+        cout << "[ Front Cache ]  \tProbes : " << Probes << "  Hits : " << Storage::FrontCache::TotalHits  //
+             << "  Hit Rate : " << 100.0 * Storage::FrontCache::TotalHits / Probes << "%\n";
+
+    if ( !Shared::Attached ) CheckOccupancy( Storage::Puzzle::Archive );
 
     cin.ignore();
 
@@ -525,7 +2275,7 @@ int main( int argc, const char* argv[] )
     for ( auto NextMove = ExplorationResult.BestMove;  //
           NextMove != Future::NoMove;                  //
           CurrentPuzzle <<= NextMove,                  //
-          NextMove = Storage::Proxy[ CurrentPuzzle.Key ].BestFuture.BestMove )
+          NextMove = Recall( CurrentPuzzle ).BestMove )
     {
         auto Options = CurrentPuzzle.Options();
         cout << CurrentPuzzle << "Picking: " << NextMove;
@@ -536,7 +2286,8 @@ int main( int argc, const char* argv[] )
     cout << CurrentPuzzle << "END" << endl;
     cin.ignore();
 
-    for ( auto& Bucket : Storage::Puzzle::Archive ) vector<Storage::Puzzle>().swap( Bucket );
+    if ( Shared::Attached ) Shared::Detach( SharedName ? SharedName : SHARED_NAME, true );
+    Storage::Release();
     cout << "Deallocation Complete";
     return 0;
 }
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+# Fits PREDICTION_FIT, PREDICTION_SPREAD, PREDICTION_FITTED and PREDICTION_TIME_SCALE of includes/constants.h
+#
+#   prediction/fit.py BINARY              fit from the exact counts already in counts.txt
+#   prediction/fit.py BINARY --solve 1200 first solve every board without a count, giving up after 1200 s each
+#
+# boards.txt holds the boards in the puzzle.txt layout, separated by blank lines. counts.txt has one line per board,
+# in the same order: name, exact state count or "unsolved", solve seconds. Solve on an idle machine, the seconds set
+# the time scale. BINARY must be built with the PREDICTION_SAMPLES and PREDICTION_BUDGET the fit is meant for.
+
+import math, os, re, subprocess, sys, tempfile, time
+
+Here = os.path.dirname( os.path.abspath( __file__ ) )
+
+
+def Boards():
+    Rows, Result = [], []
+    for Line in open( os.path.join( Here, 'boards.txt' ) ):
+        if len( Line.strip() ) >= 8: Rows.append( Line.strip() )
+        if len( Rows ) == 8: Result, Rows = Result + [ '\n'.join( Rows ) + '\n' ], []
+    return Result
+
+
+def Counts():
+    Result = []
+    if os.path.exists( os.path.join( Here, 'counts.txt' ) ):
+        for Line in open( os.path.join( Here, 'counts.txt' ) ):
+            Name, Count, Seconds = Line.split()
+            Result.append( ( Name, None if Count == 'unsolved' else int( Count ), float( Seconds ) ) )
+    return Result
+
+
+def Run( Binary, Board, Arguments, Timeout = None ):
+    with tempfile.TemporaryDirectory() as Directory:
+        open( os.path.join( Directory, 'puzzle.txt' ), 'w' ).write( Board )
+        Start = time.monotonic()
+        try:
+            Output = subprocess.run( [ Binary ] + Arguments, cwd = Directory, stdin = subprocess.DEVNULL, capture_output = True,
+                                     timeout = Timeout ).stdout.decode( errors = 'replace' )
+        except subprocess.TimeoutExpired:
+            Output = ''
+        return Output, time.monotonic() - Start
+
+
+def Predict( Binary, Board ):
+    Output, _ = Run( Binary, Board, [ '--predict' ] )
+    Number = lambda Label: float( re.search( Label + r' : ([0-9.]+)', Output ).group( 1 ) )
+    return Number( 'Colours' ), Number( 'Mean' ), Number( 'Median' ), Number( 'Endgame Cost' ) * 1e-6
+
+
+def Solve( Binary, Board, Timeout ):
+    Output, Seconds = Run( Binary, Board, [], Timeout )
+    Entries = re.search( r'\[ Hash Index \].*?Entries : ([0-9]+)', Output )
+    return ( int( Entries.group( 1 ) ) if Entries else None ), Seconds
+
+
+def LeastSquares( Rows, Targets ): # normal equations, Gaussian elimination with partial pivoting
+    Size = len( Rows[ 0 ] )
+    Matrix = [ [ sum( Row[ i ] * Row[ j ] for Row in Rows ) for j in range( Size ) ] + [ sum( Row[ i ] * y for Row, y in zip( Rows, Targets ) ) ]
+               for i in range( Size ) ]
+    for Column in range( Size ):
+        Pivot = max( range( Column, Size ), key = lambda r: abs( Matrix[ r ][ Column ] ) )
+        Matrix[ Column ], Matrix[ Pivot ] = Matrix[ Pivot ], Matrix[ Column ]
+        for r in range( Size ):
+            if r != Column:
+                Factor = Matrix[ r ][ Column ] / Matrix[ Column ][ Column ]
+                Matrix[ r ] = [ a - Factor * b for a, b in zip( Matrix[ r ], Matrix[ Column ] ) ]
+    return [ Matrix[ i ][ Size ] / Matrix[ i ][ i ] for i in range( Size ) ]
+
+
+def main():
+    if len( sys.argv ) < 2: sys.exit( 'usage: prediction/fit.py BINARY [--solve SECONDS]' )
+    Binary = os.path.abspath( sys.argv[ 1 ] )
+    Timeout = float( sys.argv[ sys.argv.index( '--solve' ) + 1 ] ) if '--solve' in sys.argv else None
+
+    AllBoards, Known = Boards(), Counts()
+    if Timeout:
+        for n, Board in enumerate( AllBoards ):
+            if n < len( Known ): continue
+            Count, Seconds = Solve( Binary, Board, Timeout )
+            Known.append( ( 'board%03d' % n, Count, Seconds ) )
+            with open( os.path.join( Here, 'counts.txt' ), 'a' ) as File:
+                File.write( '%s %s %.2f\n' % ( Known[ -1 ][ 0 ], Count if Count else 'unsolved', Seconds ) )
+            print( Known[ -1 ], flush = True )
+
+    Rows, Targets, Scales, Names = [], [], [], []
+    for Board, ( Name, Count, Seconds ) in zip( AllBoards, Known ):
+        if not Count: continue
+        Colours, Mean, Median, Cost = Predict( Binary, Board )
+        Rows.append( [ 1.0, math.log( Mean ), math.log( Median ), Colours ] )
+        Targets.append( math.log( Count ) )
+        Names.append( Name )
+        if Count >= 100000: Scales.append( math.log( Seconds / ( Count * Cost ) ) ) # smaller solves are mostly start up
+
+    Fit = LeastSquares( Rows, Targets )
+    Residuals = []
+    for Left in range( len( Rows ) ):
+        Others = [ i for i in range( len( Rows ) ) if i != Left ]
+        Partial = LeastSquares( [ Rows[ i ] for i in Others ], [ Targets[ i ] for i in Others ] )
+        Residuals.append( Targets[ Left ] - sum( a * b for a, b in zip( Partial, Rows[ Left ] ) ) )
+    Spread = math.sqrt( sum( r * r for r in Residuals ) / len( Residuals ) )
+    Inside = sum( abs( r ) <= 1.96 * Spread for r in Residuals )
+    Scale = math.exp( sum( Scales ) / len( Scales ) )
+    ScaleSpread = math.sqrt( sum( ( s - math.log( Scale ) ) ** 2 for s in Scales ) / len( Scales ) )
+
+    print( 'Boards : %d of %d solved  Inside 95%% with each left out : %d  Largest : %d' %  #
+           ( len( Rows ), len( AllBoards ), Inside, max( math.exp( t ) for t in Targets ) ) )
+    print( 'Time scale over %d boards, spread in log : %.3f' % ( len( Scales ), ScaleSpread ) )
+    for Name, Residual in zip( Names, Residuals ):
+        if abs( Residual ) > 1.96 * Spread: print( 'Outside : %s  log( exact / fitted ) %.2f' % ( Name, Residual ) )
+    print( 'constexpr double PREDICTION_FIT[]    = { %.3f, %.3f, %.3f, %.3f };' % tuple( Fit ) )
+    print( 'constexpr auto PREDICTION_SPREAD     = %.3f;' % Spread )
+    print( 'constexpr auto PREDICTION_FITTED     = %d;' % round( max( math.exp( t ) for t in Targets ) ) )
+    print( 'constexpr auto PREDICTION_TIME_SCALE = %.2f;' % Scale )
+
+
+main()